@@ -200,7 +200,7 @@ namespace graphene { namespace app {
        FC_ASSERT( _app.p2p_node() != nullptr, "Not connected to P2P network, can't broadcast!" );
        _app.chain_database()->precompute_parallel( b ).wait();
        _app.chain_database()->push_block(b);
-       _app.p2p_node()->broadcast( net::block_message( b ));
+       _app.p2p_node()->broadcast( net::block_message::from_block( b ) );
     }
 
     void network_broadcast_api::broadcast_transaction_with_callback(confirmation_callback cb, const precomputable_transaction& trx)
@@ -841,26 +841,85 @@ namespace graphene { namespace app {
 
       auto plugin = _app.get_plugin<graphene::grouped_orders::grouped_orders_plugin>( "grouped_orders" );
       FC_ASSERT( plugin );
-      const auto& limit_groups = plugin->limit_order_groups();
       vector< limit_order_group > result;
 
       asset_id_type base_asset_id = database_api.get_asset_id_from_string( base_asset );
       asset_id_type quote_asset_id = database_api.get_asset_id_from_string( quote_asset );
 
-      price max_price = price::max( base_asset_id, quote_asset_id );
-      price min_price = price::min( base_asset_id, quote_asset_id );
+      const auto* book = plugin->limit_order_groups( group, base_asset_id, quote_asset_id );
+      if( book == nullptr )
+         return result;
+
+      auto itr = book->begin();
       if( start.valid() && !start->is_null() )
+      {
+         price max_price = price::max( base_asset_id, quote_asset_id );
+         price min_price = price::min( base_asset_id, quote_asset_id );
          max_price = std::max( std::min( max_price, *start ), min_price );
+         itr = std::lower_bound( book->begin(), book->end(), limit_order_group_key( group, max_price ),
+                                 []( const limit_order_group_entry& e, const limit_order_group_key& k )
+                                 { return e.first < k; } );
+      }
+      // the book is sorted, so the result is a slice of it
+      auto end = itr + std::min< size_t >( limit, book->end() - itr );
+      result.assign( itr, end );
+      return result;
+   }
 
-      auto itr = limit_groups.lower_bound( limit_order_group_key( group, max_price ) );
-      // use an end iterator to try to avoid expensive price comparison
-      auto end = limit_groups.upper_bound( limit_order_group_key( group, min_price ) );
-      while( itr != end && result.size() < limit )
+   void orders_api::subscribe_to_grouped_limit_orders( std::function<void(const variant&)> callback,
+                                                       std::string base_asset,
+                                                       std::string quote_asset,
+                                                       uint16_t group )
+   {
+      auto plugin = _app.get_plugin<graphene::grouped_orders::grouped_orders_plugin>( "grouped_orders" );
+      FC_ASSERT( plugin );
+      FC_ASSERT( plugin->tracked_groups().find( group ) != plugin->tracked_groups().end(),
+                 "Group ${g} is not tracked", ("g",group) );
+
+      limit_order_group_book_key key( group, database_api.get_asset_id_from_string( base_asset ),
+                                      database_api.get_asset_id_from_string( quote_asset ) );
+      FC_ASSERT( key.base != key.quote );
+      if( _grouped_orders_subscriptions.find( key ) == _grouped_orders_subscriptions.end() )
       {
-         result.emplace_back( *itr );
-         ++itr;
+         const auto configured_limit = _app.get_options().api_limit_grouped_orders_subscriptions;
+         FC_ASSERT( _grouped_orders_subscriptions.size() < configured_limit,
+                    "Can not subscribe to more than ${configured_limit} markets and groups",
+                    ("configured_limit", configured_limit) );
+      }
+      _grouped_orders_subscriptions[ key ] = callback;
+
+      if( !_grouped_orders_connection.connected() )
+         _grouped_orders_connection = plugin->limit_order_groups_changed.connect(
+               [this]( const vector<limit_order_group_book_diff>& diffs ) { on_grouped_orders_changed( diffs ); } );
+   }
+
+   void orders_api::unsubscribe_from_grouped_limit_orders( std::string base_asset,
+                                                           std::string quote_asset,
+                                                           uint16_t group )
+   {
+      limit_order_group_book_key key( group, database_api.get_asset_id_from_string( base_asset ),
+                                      database_api.get_asset_id_from_string( quote_asset ) );
+      _grouped_orders_subscriptions.erase( key );
+      if( _grouped_orders_subscriptions.empty() )
+         _grouped_orders_connection.disconnect();
+   }
+
+   void orders_api::on_grouped_orders_changed( const vector<limit_order_group_book_diff>& diffs )
+   {
+      /// we need to ensure the orders_api is not deleted for the life of the async operation
+      auto capture_this = shared_from_this();
+      for( const auto& diff : diffs )
+      {
+         auto itr = _grouped_orders_subscriptions.find( limit_order_group_book_key( diff.group, diff.base,
+                                                                                      diff.quote ) );
+         if( itr == _grouped_orders_subscriptions.end() )
+            continue;
+         auto& callback = itr->second;
+         auto v = fc::variant( diff, GRAPHENE_MAX_NESTED_OBJECTS );
+         fc::async( [capture_this,v,callback]() {
+            callback(v);
+         } );
       }
-      return result;
    }
 
    // custom operations api
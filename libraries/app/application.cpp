@@ -49,6 +49,7 @@
 #include <boost/signals2.hpp>
 #include <boost/range/algorithm/reverse.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
 
 #include <iostream>
 
@@ -254,6 +255,9 @@ void application_impl::initialize(const fc::path& data_dir, shared_ptr<boost::pr
    if ( _options->count("enable-subscribe-to-all") > 0 )
       _app_options.enable_subscribe_to_all = _options->at( "enable-subscribe-to-all" ).as<bool>();
 
+   if ( _options->count("enable-api-streams") > 0 )
+      _app_options.enable_api_streams = _options->at( "enable-api-streams" ).as<bool>();
+
    set_api_limit();
 
    if( is_plugin_enabled( "market_history" ) )
@@ -434,6 +438,18 @@ void application_impl::set_api_limit() {
       _app_options.api_limit_get_credit_offers =
             _options->at("api-limit-get-credit-offers").as<uint64_t>();
    }
+   if(_options->count("api-limit-stream-pages-in-flight") > 0) {
+      _app_options.api_limit_stream_pages_in_flight =
+            _options->at("api-limit-stream-pages-in-flight").as<uint64_t>();
+   }
+   if(_options->count("api-limit-stream-bytes-in-flight") > 0) {
+      _app_options.api_limit_stream_bytes_in_flight =
+            _options->at("api-limit-stream-bytes-in-flight").as<uint64_t>();
+   }
+   if(_options->count("api-limit-grouped-orders-subscriptions") > 0) {
+      _app_options.api_limit_grouped_orders_subscriptions =
+            _options->at("api-limit-grouped-orders-subscriptions").as<uint64_t>();
+   }
 }
 
 graphene::chain::genesis_state_type application_impl::initialize_genesis_state() const
@@ -444,7 +460,8 @@ graphene::chain::genesis_state_type application_impl::initialize_genesis_state()
       {
          std::string genesis_str;
          fc::read_file_contents( _options->at("genesis-json").as<boost::filesystem::path>(), genesis_str );
-         auto genesis = fc::json::from_string( genesis_str ).as<graphene::chain::genesis_state_type>( 20 );
+         auto genesis = graphene::chain::genesis_state_type::from_variant_parallel( fc::json::from_string( genesis_str ),
+                                                                                    20 );
          bool modified_genesis = false;
          if( _options->count("genesis-timestamp") > 0 )
          {
@@ -482,7 +499,8 @@ graphene::chain::genesis_state_type application_impl::initialize_genesis_state()
          graphene::egenesis::compute_egenesis_json( egenesis_json );
          FC_ASSERT( egenesis_json != "" );
          FC_ASSERT( graphene::egenesis::get_egenesis_json_hash() == fc::sha256::hash( egenesis_json ) );
-         auto genesis = fc::json::from_string( egenesis_json ).as<graphene::chain::genesis_state_type>( 20 );
+         auto genesis = graphene::chain::genesis_state_type::from_variant_parallel(
+                              fc::json::from_string( egenesis_json ), 20 );
          genesis.initial_chain_id = fc::sha256::hash( egenesis_json );
          return genesis;
       }
@@ -514,6 +532,32 @@ void application_impl::open_chain_database() const
       _chain_db->enable_standby_votes_tracking( _options->at("enable-standby-votes-tracking").as<bool>() );
    }
 
+   if( _options->count("trace-blocks") > 0 || _options->count("trace-slow-blocks-ms") > 0 )
+   {
+      uint32_t first_block = 0;
+      uint32_t last_block = 0;
+      if( _options->count("trace-blocks") > 0 )
+      {
+         const string range = _options->at("trace-blocks").as<string>();
+         const auto pos = range.find('-');
+         FC_ASSERT( pos != string::npos, "trace-blocks must be a range of block numbers, e.g. 1000-1010" );
+         first_block = boost::lexical_cast<uint32_t>( range.substr( 0, pos ) );
+         last_block = boost::lexical_cast<uint32_t>( range.substr( pos + 1 ) );
+      }
+      fc::microseconds threshold;
+      if( _options->count("trace-slow-blocks-ms") > 0 )
+         threshold = fc::milliseconds( _options->at("trace-slow-blocks-ms").as<uint32_t>() );
+      fc::path trace_dir = _data_dir / "traces";
+      if( _options->count("trace-dir") > 0 )
+      {
+         trace_dir = _options->at("trace-dir").as<boost::filesystem::path>();
+         if( trace_dir.is_relative() )
+            trace_dir = _data_dir / trace_dir;
+      }
+      _chain_db->get_block_tracer().enable( trace_dir, first_block, last_block, threshold );
+      ilog( "Writing block traces to ${d}", ("d", trace_dir) );
+   }
+
    if( _options->count("replay-blockchain") > 0 || _options->count("revalidate-blockchain") > 0 )
       _chain_db->wipe( _data_dir / "blockchain", false );
 
@@ -665,10 +709,7 @@ bool application_impl::handle_block(const graphene::net::block_message& blk_msg,
          contained_transaction_msg_ids.reserve( contained_transaction_msg_ids.size()
                                                     + blk_msg.block.transactions.size() );
          for (const processed_transaction& ptrx : blk_msg.block.transactions)
-         {
-            graphene::net::trx_message transaction_message(ptrx);
-            contained_transaction_msg_ids.emplace_back(graphene::net::message(transaction_message).id());
-         }
+            contained_transaction_msg_ids.emplace_back(graphene::net::trx_message::from_transaction(ptrx).id());
       }
 
       return result;
@@ -784,13 +825,14 @@ message application_impl::get_item(const item_id& id)
   // ilog("Request for item ${id}", ("id", id));
    if( id.item_type == graphene::net::block_message_type )
    {
-      auto opt_block = _chain_db->fetch_block_by_id(id.item_hash);
+      // The stored block is sent as is, without unpacking it and packing it again
+      auto opt_block = _chain_db->fetch_packed_block_by_id(id.item_hash);
       if( !opt_block )
          elog("Couldn't find block ${id} -- corresponding ID in our chain is ${id2}",
               ("id", id.item_hash)("id2", _chain_db->get_block_id_for_num(block_header::num_from_id(id.item_hash))));
       FC_ASSERT( opt_block.valid() );
-      // ilog("Serving up block #${num}", ("num", opt_block->block_num()));
-      return block_message(std::move(*opt_block));
+      // ilog("Serving up block #${num}", ("num", block_header::num_from_id(id.item_hash)));
+      return block_message::from_packed_block( std::move(*opt_block), id.item_hash );
    }
    return trx_message( _chain_db->get_recent_transaction( id.item_hash ) );
 } FC_CAPTURE_AND_RETHROW( (id) ) }
@@ -1163,9 +1205,17 @@ void application::set_program_options(boost::program_options::options_descriptio
           "Number of IO threads, default to 0 for auto-configuration")
          ("enable-subscribe-to-all", bpo::value<bool>()->implicit_value(true),
           "Whether allow API clients to subscribe to universal object creation and removal events")
+         ("enable-api-streams", bpo::value<bool>()->implicit_value(true),
+          "Whether allow API clients to stream all accounts or full order books, default false")
          ("enable-standby-votes-tracking", bpo::value<bool>()->implicit_value(true),
           "Whether to enable tracking of votes of standby witnesses and committee members. "
           "Set it to true to provide accurate data to API clients, set to false for slightly better performance.")
+         ("trace-blocks", bpo::value<string>(),
+          "Write a Chrome trace of the processing of the blocks in this range, e.g. 1000-1010")
+         ("trace-slow-blocks-ms", bpo::value<uint32_t>(),
+          "Write a Chrome trace of every block which takes at least this many milliseconds to apply")
+         ("trace-dir", bpo::value<boost::filesystem::path>(),
+          "Directory to write block traces to, relative to data-dir (traces)")
          ("api-limit-get-account-history-operations",
           bpo::value<uint64_t>()->default_value(default_opts.api_limit_get_account_history_operations),
           "For history_api::get_account_history_operations to set max limit value")
@@ -1268,6 +1318,17 @@ void application::set_program_options(boost::program_options::options_descriptio
          ("api-limit-get-credit-offers",
           bpo::value<uint64_t>()->default_value(default_opts.api_limit_get_credit_offers),
           "Set maximum limit value for database APIs which query for credit offers or credit deals")
+         ("api-limit-stream-pages-in-flight",
+          bpo::value<uint64_t>()->default_value(default_opts.api_limit_stream_pages_in_flight),
+          "Set maximum number of pages which a database API stream sends before the client acknowledges them")
+         ("api-limit-stream-bytes-in-flight",
+          bpo::value<uint64_t>()->default_value(default_opts.api_limit_stream_bytes_in_flight),
+          "Set maximum size in bytes of the pages which a connection's database API stream has sent "
+          "and the client has not acknowledged yet")
+         ("api-limit-grouped-orders-subscriptions",
+          bpo::value<uint64_t>()->default_value(default_opts.api_limit_grouped_orders_subscriptions),
+          "Set maximum number of markets and groups which a connection can subscribe to "
+          "with orders_api::subscribe_to_grouped_limit_orders")
          ;
    command_line_options.add(configuration_file_options);
    command_line_options.add_options()
@@ -31,6 +31,7 @@
 #include <graphene/protocol/restriction_predicate.hpp>
 
 #include <fc/crypto/hex.hpp>
+#include <fc/io/raw_variant.hpp>
 #include <fc/rpc/api_connection.hpp>
 
 #include <boost/range/iterator_range.hpp>
@@ -99,6 +100,7 @@ database_api_impl::database_api_impl( graphene::chain::database& db, const appli
 database_api_impl::~database_api_impl()
 {
    dlog("freeing database api ${x}", ("x",int64_t(this)) );
+   wake_up_stream(); // lets a waiting stream task end now
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -133,6 +135,34 @@ fc::variants database_api_impl::get_objects( const vector<object_id_type>& ids,
    return result;
 }
 
+vector<optional<packed_object>> database_api::get_packed_objects( const vector<object_id_type>& ids,
+                                                                  optional<bool> subscribe )const
+{
+   return my->get_packed_objects( ids, subscribe );
+}
+
+vector<optional<packed_object>> database_api_impl::get_packed_objects( const vector<object_id_type>& ids,
+                                                                       optional<bool> subscribe )const
+{
+   bool to_subscribe = get_whether_to_subscribe( subscribe );
+
+   vector<optional<packed_object>> result;
+   result.reserve(ids.size());
+
+   std::transform(ids.begin(), ids.end(), std::back_inserter(result),
+                  [this,to_subscribe](object_id_type id) -> optional<packed_object> {
+      if(auto obj = _db.find_object(id))
+      {
+         if( to_subscribe && !id.is<operation_history_id_type>() && !id.is<account_transaction_history_id_type>() )
+            this->subscribe_to_item( id );
+         return packed_object{ id, obj->pack() };
+      }
+      return {};
+   });
+
+   return result;
+}
+
 //////////////////////////////////////////////////////////////////////
 //                                                                  //
 // Subscriptions                                                    //
@@ -207,6 +237,183 @@ void database_api_impl::cancel_all_subscriptions( bool reset_callback, bool rese
    _subscribe_filter = fc::bloom_filter(param);
 }
 
+void database_api::stream_accounts( std::function<void(const variant&)> callback, const string& lower_bound_name )
+{
+   my->stream_accounts( callback, lower_bound_name );
+}
+
+void database_api_impl::stream_accounts( std::function<void(const variant&)> callback,
+                                         const string& lower_bound_name )
+{
+   FC_ASSERT( _app_options && _app_options->enable_api_streams, "Streaming is disabled in this server" );
+   const auto page_size = _app_options->api_limit_lookup_accounts;
+   FC_ASSERT( page_size > 0, "Looking up accounts is disabled in this server" );
+
+   start_stream( callback, [this,page_size,next_name=lower_bound_name]( fc::variants& page ) mutable {
+      const auto& accounts_by_name = _db.get_index_type<account_index>().indices().get<by_name>();
+      auto itr = accounts_by_name.lower_bound( next_name );
+      auto end = accounts_by_name.end();
+      for( ; itr != end && page.size() < page_size; ++itr )
+         page.emplace_back( std::make_pair( itr->name, itr->get_id() ), 2 );
+      if( itr == end )
+         return false;
+      next_name = itr->name;
+      return true;
+   });
+}
+
+void database_api::stream_limit_orders( std::function<void(const variant&)> callback,
+                                        const std::string& a, const std::string& b )
+{
+   my->stream_limit_orders( callback, a, b );
+}
+
+void database_api_impl::stream_limit_orders( std::function<void(const variant&)> callback,
+                                             const std::string& a, const std::string& b )
+{
+   FC_ASSERT( _app_options && _app_options->enable_api_streams, "Streaming is disabled in this server" );
+   const auto page_size = _app_options->api_limit_get_limit_orders;
+   FC_ASSERT( page_size > 0, "Querying limit orders is disabled in this server" );
+
+   const asset_id_type asset_a_id = get_asset_from_string(a)->id;
+   const asset_id_type asset_b_id = get_asset_from_string(b)->id;
+   FC_ASSERT( asset_a_id != asset_b_id, "Base and quote assets must be different" );
+
+   start_stream( callback, [this,page_size,asset_b_id,
+                            next_price=price::max(asset_a_id,asset_b_id),next_id=object_id_type()]
+                           ( fc::variants& page ) mutable {
+      const auto& limit_price_idx = _db.get_index_type<limit_order_index>().indices().get<by_price>();
+      while( page.size() < page_size )
+      {
+         auto itr = limit_price_idx.lower_bound( std::make_tuple( next_price, next_id ) );
+         auto end = limit_price_idx.upper_bound( price::min( next_price.base.asset_id, next_price.quote.asset_id ) );
+         for( ; itr != end && page.size() < page_size; ++itr )
+            page.emplace_back( itr->to_variant() );
+         if( itr != end )
+         {
+            next_price = itr->sell_price;
+            next_id = itr->id;
+            return true;
+         }
+         if( next_price.base.asset_id == asset_b_id ) // both sides are done
+            return false;
+         next_price = price::max( asset_b_id, next_price.base.asset_id );
+         next_id = object_id_type();
+      }
+      return true;
+   });
+}
+
+void database_api::ack_stream_pages( uint32_t count )
+{
+   my->ack_stream_pages( count );
+}
+
+void database_api_impl::ack_stream_pages( uint32_t count )
+{
+   FC_ASSERT( count <= _stream_pages_in_flight.size(),
+              "Only ${n} pages of the stream are not acknowledged yet", ("n", _stream_pages_in_flight.size()) );
+   for( ; count > 0; --count )
+   {
+      _stream_bytes_in_flight -= _stream_pages_in_flight.front();
+      _stream_pages_in_flight.pop_front();
+   }
+   wake_up_stream();
+}
+
+void database_api::cancel_stream()
+{
+   my->cancel_stream();
+}
+
+void database_api_impl::cancel_stream()
+{
+   ++_current_stream_id;
+   _stream_pages_in_flight.clear();
+   _stream_bytes_in_flight = 0;
+   wake_up_stream();
+}
+
+void database_api_impl::wake_up_stream()
+{
+   if( _stream_wakeup )
+   {
+      _stream_wakeup->set_value();
+      _stream_wakeup.reset();
+   }
+}
+
+bool database_api_impl::stream_can_send( size_t page_bytes )const
+{
+   // a page is always sent when nothing is in flight, even if it is larger than the budget alone
+   if( _stream_pages_in_flight.empty() )
+      return true;
+   return _stream_pages_in_flight.size() < _app_options->api_limit_stream_pages_in_flight
+          && _stream_bytes_in_flight + page_bytes <= _app_options->api_limit_stream_bytes_in_flight;
+}
+
+void database_api_impl::start_stream( std::function<void(const variant&)> callback,
+                                      std::function<bool(fc::variants& page)> next_page )
+{
+   cancel_stream();
+   const uint64_t stream_id = _current_stream_id;
+   std::weak_ptr<database_api_impl> weak_this = shared_from_this();
+   fc::async( [weak_this,stream_id,callback,next_page](){
+      try
+      {
+         optional<fc::variant> page; // built, but waiting for the client to acknowledge earlier pages
+         size_t page_bytes = 0;
+         bool more = true;
+         while( more || page.valid() )
+         {
+            fc::promise<void>::ptr wakeup;
+            {
+               auto self = weak_this.lock();
+               if( !self || self->_current_stream_id != stream_id )
+                  return;
+               if( !page.valid() )
+               {
+                  fc::variants entries;
+                  more = next_page( entries );
+                  page = fc::variant( entries );
+                  page_bytes = fc::raw::pack_size( *page );
+               }
+               if( self->stream_can_send( page_bytes ) )
+               {
+                  self->_stream_pages_in_flight.push_back( page_bytes );
+                  self->_stream_bytes_in_flight += page_bytes;
+                  callback( *page );
+                  page.reset();
+               }
+               else
+               {
+                  self->_stream_wakeup = fc::promise<void>::create( "database_api stream wakeup" );
+                  wakeup = self->_stream_wakeup;
+               }
+            }
+            if( wakeup )
+               wakeup->wait( fc::seconds( GRAPHENE_API_STREAM_ACK_TIMEOUT_SECONDS ) );
+            else
+               fc::yield();
+         }
+         auto self = weak_this.lock();
+         if( self && self->_current_stream_id == stream_id )
+            callback( fc::variant() );
+      }
+      catch( const fc::timeout_exception& )
+      {
+         wlog( "Stopped streaming because the client did not acknowledge the pages it received" );
+         auto self = weak_this.lock();
+         if( self && self->_current_stream_id == stream_id )
+            self->cancel_stream();
+      }
+      catch( const fc::exception& e )
+      {
+         wlog( "Stopped streaming after error: ${e}", ("e", e.to_detail_string()) );
+      }
+   });
+}
+
 //////////////////////////////////////////////////////////////////////
 //                                                                  //
 // Blocks and transactions                                          //
@@ -489,8 +696,35 @@ std::map<std::string, full_account> database_api_impl::get_full_accounts( const
 
    std::map<std::string, full_account> results;
 
+   // Look up the indexes once for all the accounts
+   const size_t api_limit_get_full_accounts_lists = static_cast<size_t>(
+             _app_options->api_limit_get_full_accounts_lists );
+
+   const graphene::chain::required_approval_index* proposals_by_account = nullptr;
+   if( _app_options->has_api_helper_indexes_plugin )
+   {
+      proposals_by_account = &_db.get_index_type< primary_index< proposal_index > >()
+                                 .get_secondary_index< graphene::chain::required_approval_index >();
+   }
+   const auto& balances_by_account = _db.get_index_type< primary_index< account_balance_index > >()
+                                        .get_secondary_index< balances_by_account_index >();
+   const auto& vesting_by_account = _db.get_index_type<vesting_balance_index>().indices().get<by_account>();
+   const auto& limit_orders_by_account = _db.get_index_type<limit_order_index>().indices().get<by_account>();
+   const auto& call_orders_by_account = _db.get_index_type<call_order_index>().indices().get<by_account>();
+   const auto& settles_by_account = _db.get_index_type<force_settlement_index>().indices().get<by_account>();
+   const auto& assets_by_issuer = _db.get_index_type<asset_index>().indices().get<by_issuer>();
+   const auto& withdraw_indices = _db.get_index_type<withdraw_permission_index>().indices();
+   const auto& withdraws_by_from = withdraw_indices.get<by_from>();
+   const auto& withdraws_by_authorized = withdraw_indices.get<by_authorized>();
+   const auto& htlc_indices = _db.get_index_type<htlc_index>().indices();
+   const auto& htlcs_by_from = htlc_indices.get<by_from_id>();
+   const auto& htlcs_by_to = htlc_indices.get<by_to_id>();
+
    for (const std::string& account_name_or_id : names_or_ids)
    {
+      if( results.find( account_name_or_id ) != results.end() ) // duplicate
+         continue;
+
       const account_object* account = get_account_from_string(account_name_or_id, false);
       if (account == nullptr)
          continue;
@@ -503,7 +737,8 @@ std::map<std::string, full_account> database_api_impl::get_full_accounts( const
          }
       }
 
-      full_account acnt;
+      // Build the result in place
+      full_account& acnt = results[account_name_or_id];
       acnt.account = *account;
       acnt.statistics = account->statistics(_db);
       acnt.registrar_name = account->registrar(_db).name;
@@ -517,18 +752,11 @@ std::map<std::string, full_account> database_api_impl::get_full_accounts( const
          acnt.cashback_balance = account->cashback_balance(_db);
       }
 
-      size_t api_limit_get_full_accounts_lists = static_cast<size_t>(
-                _app_options->api_limit_get_full_accounts_lists );
-
       // Add the account's proposals (if the data is available)
-      if( _app_options && _app_options->has_api_helper_indexes_plugin )
+      if( proposals_by_account != nullptr )
       {
-         const auto& proposal_idx = _db.get_index_type< primary_index< proposal_index > >();
-         const auto& proposals_by_account = proposal_idx.get_secondary_index<
-                                                  graphene::chain::required_approval_index>();
-
-         auto required_approvals_itr = proposals_by_account._account_to_proposals.find( account->id );
-         if( required_approvals_itr != proposals_by_account._account_to_proposals.end() )
+         auto required_approvals_itr = proposals_by_account->_account_to_proposals.find( account->id );
+         if( required_approvals_itr != proposals_by_account->_account_to_proposals.end() )
          {
             acnt.proposals.reserve( std::min(required_approvals_itr->second.size(),
                                              api_limit_get_full_accounts_lists) );
@@ -544,8 +772,7 @@ std::map<std::string, full_account> database_api_impl::get_full_accounts( const
       }
 
       // Add the account's balances
-      const auto& balances = _db.get_index_type< primary_index< account_balance_index > >().
-            get_secondary_index< balances_by_account_index >().get_account_balances( account->id );
+      const auto& balances = balances_by_account.get_account_balances( account->id );
       for( const auto& balance : balances )
       {
          if(acnt.balances.size() >= api_limit_get_full_accounts_lists) {
@@ -556,8 +783,7 @@ std::map<std::string, full_account> database_api_impl::get_full_accounts( const
       }
 
       // Add the account's vesting balances
-      auto vesting_range = _db.get_index_type<vesting_balance_index>().indices().get<by_account>()
-                              .equal_range(account->id);
+      auto vesting_range = vesting_by_account.equal_range(account->id);
       for(auto itr = vesting_range.first; itr != vesting_range.second; ++itr)
       {
          if(acnt.vesting_balances.size() >= api_limit_get_full_accounts_lists) {
@@ -568,8 +794,7 @@ std::map<std::string, full_account> database_api_impl::get_full_accounts( const
       }
 
       // Add the account's orders
-      auto order_range = _db.get_index_type<limit_order_index>().indices().get<by_account>()
-                            .equal_range(account->id);
+      auto order_range = limit_orders_by_account.equal_range(account->id);
       for(auto itr = order_range.first; itr != order_range.second; ++itr)
       {
          if(acnt.limit_orders.size() >= api_limit_get_full_accounts_lists) {
@@ -578,7 +803,7 @@ std::map<std::string, full_account> database_api_impl::get_full_accounts( const
          }
          acnt.limit_orders.emplace_back(*itr);
       }
-      auto call_range = _db.get_index_type<call_order_index>().indices().get<by_account>().equal_range(account->id);
+      auto call_range = call_orders_by_account.equal_range(account->id);
       for(auto itr = call_range.first; itr != call_range.second; ++itr)
       {
          if(acnt.call_orders.size() >= api_limit_get_full_accounts_lists) {
@@ -587,8 +812,7 @@ std::map<std::string, full_account> database_api_impl::get_full_accounts( const
          }
          acnt.call_orders.emplace_back(*itr);
       }
-      auto settle_range = _db.get_index_type<force_settlement_index>().indices().get<by_account>()
-                             .equal_range(account->id);
+      auto settle_range = settles_by_account.equal_range(account->id);
       for(auto itr = settle_range.first; itr != settle_range.second; ++itr)
       {
          if(acnt.settle_orders.size() >= api_limit_get_full_accounts_lists) {
@@ -599,7 +823,7 @@ std::map<std::string, full_account> database_api_impl::get_full_accounts( const
       }
 
       // get assets issued by user
-      auto asset_range = _db.get_index_type<asset_index>().indices().get<by_issuer>().equal_range(account->id);
+      auto asset_range = assets_by_issuer.equal_range(account->id);
       for(auto itr = asset_range.first; itr != asset_range.second; ++itr)
       {
          if(acnt.assets.size() >= api_limit_get_full_accounts_lists) {
@@ -610,8 +834,7 @@ std::map<std::string, full_account> database_api_impl::get_full_accounts( const
       }
 
       // get withdraws permissions
-      auto withdraw_indices = _db.get_index_type<withdraw_permission_index>().indices();
-      auto withdraw_from_range = withdraw_indices.get<by_from>().equal_range(account->id);
+      auto withdraw_from_range = withdraws_by_from.equal_range(account->id);
       for(auto itr = withdraw_from_range.first; itr != withdraw_from_range.second; ++itr)
       {
          if(acnt.withdraws_from.size() >= api_limit_get_full_accounts_lists) {
@@ -620,7 +843,7 @@ std::map<std::string, full_account> database_api_impl::get_full_accounts( const
          }
          acnt.withdraws_from.emplace_back(*itr);
       }
-      auto withdraw_authorized_range = withdraw_indices.get<by_authorized>().equal_range(account->id);
+      auto withdraw_authorized_range = withdraws_by_authorized.equal_range(account->id);
       for(auto itr = withdraw_authorized_range.first; itr != withdraw_authorized_range.second; ++itr)
       {
          if(acnt.withdraws_to.size() >= api_limit_get_full_accounts_lists) {
@@ -631,7 +854,7 @@ std::map<std::string, full_account> database_api_impl::get_full_accounts( const
       }
 
       // get htlcs
-      auto htlc_from_range = _db.get_index_type<htlc_index>().indices().get<by_from_id>().equal_range(account->id);
+      auto htlc_from_range = htlcs_by_from.equal_range(account->id);
       for(auto itr = htlc_from_range.first; itr != htlc_from_range.second; ++itr)
       {
          if(acnt.htlcs_from.size() >= api_limit_get_full_accounts_lists) {
@@ -640,7 +863,7 @@ std::map<std::string, full_account> database_api_impl::get_full_accounts( const
          }
          acnt.htlcs_from.emplace_back(*itr);
       }
-      auto htlc_to_range = _db.get_index_type<htlc_index>().indices().get<by_to_id>().equal_range(account->id);
+      auto htlc_to_range = htlcs_by_to.equal_range(account->id);
       for(auto itr = htlc_to_range.first; itr != htlc_to_range.second; ++itr)
       {
          if(acnt.htlcs_to.size() >= api_limit_get_full_accounts_lists) {
@@ -649,8 +872,6 @@ std::map<std::string, full_account> database_api_impl::get_full_accounts( const
          }
          acnt.htlcs_to.emplace_back(*itr);
       }
-
-      results[account_name_or_id] = acnt;
    }
    return results;
 }
@@ -25,8 +25,13 @@
 #include <graphene/app/database_api.hpp>
 
 #include <fc/bloom_filter.hpp>
+#include <fc/thread/future.hpp>
+
+#include <deque>
 
 #define GET_REQUIRED_FEES_MAX_RECURSION 4
+/// A stream stops if the client does not acknowledge any of its pages for this long
+#define GRAPHENE_API_STREAM_ACK_TIMEOUT_SECONDS 60
 
 namespace graphene { namespace app {
 
@@ -41,6 +46,8 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
 
       // Objects
       fc::variants get_objects( const vector<object_id_type>& ids, optional<bool> subscribe )const;
+      vector<optional<packed_object>> get_packed_objects( const vector<object_id_type>& ids,
+                                                          optional<bool> subscribe )const;
 
       // Subscriptions
       void set_subscribe_callback( std::function<void(const variant&)> cb, bool notify_remove_create );
@@ -48,6 +55,11 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
       void set_pending_transaction_callback( std::function<void(const variant&)> cb );
       void set_block_applied_callback( std::function<void(const variant& block_id)> cb );
       void cancel_all_subscriptions(bool reset_callback, bool reset_market_subscriptions);
+      void stream_accounts( std::function<void(const variant&)> callback, const string& lower_bound_name );
+      void stream_limit_orders( std::function<void(const variant&)> callback,
+                                const std::string& a, const std::string& b );
+      void ack_stream_pages( uint32_t count );
+      void cancel_stream();
 
       // Blocks and transactions
       optional<block_header> get_block_header(uint32_t block_num)const;
@@ -495,6 +507,17 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
                               const flat_set<account_id_type>& impacted_accounts);
       void on_applied_block();
 
+      /**
+       * Sends pages produced by @p next_page to @p callback in a task, until it returns false
+       * or the stream is cancelled. @p next_page must not keep iterators between calls.
+       * The task waits for the client to acknowledge pages whenever sending the next one would exceed
+       * the pages or bytes in flight allowed per connection.
+       */
+      void start_stream( std::function<void(const variant&)> callback,
+                         std::function<bool(fc::variants& page)> next_page );
+      bool stream_can_send( size_t page_bytes )const;
+      void wake_up_stream();
+
       ////////////////////////////////////////////////
       // Member variables
       ////////////////////////////////////////////////
@@ -517,6 +540,14 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
 
       map< pair<asset_id_type,asset_id_type>, std::function<void(const variant&)> > _market_subscriptions;
 
+      /// ID of the active stream, changed to cancel it
+      uint64_t _current_stream_id = 0;
+      /// sizes of the pages which the active stream has sent and the client has not acknowledged yet
+      std::deque<size_t> _stream_pages_in_flight;
+      size_t _stream_bytes_in_flight = 0;
+      /// set to wake up the stream task when pages are acknowledged or the stream is cancelled
+      fc::promise<void>::ptr _stream_wakeup;
+
       graphene::chain::database& _db;
       const application_options* _app_options = nullptr;
 
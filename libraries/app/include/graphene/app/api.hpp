@@ -378,7 +378,7 @@ namespace graphene { namespace app {
          network_node_api(application& a);
 
          /**
-          * @brief Return general network information, such as p2p port
+          * @brief Return general network information, such as p2p port and message cache statistics
           */
          fc::variant_object get_info() const;
 
@@ -546,7 +546,7 @@ namespace graphene { namespace app {
    /**
     * @brief the orders_api class exposes access to data processed with grouped orders plugin.
     */
-   class orders_api
+   class orders_api : public std::enable_shared_from_this<orders_api>
    {
       public:
          orders_api(application& app)
@@ -575,9 +575,41 @@ namespace graphene { namespace app {
                                                                optional<price> start,
                                                                uint32_t limit )const;
 
+         /**
+          * @brief Subscribe to changes of the grouped limit orders in given market
+          *
+          * @param callback Callback method which is called after each block that changed the order groups,
+          *                 with a variant containing a @ref limit_order_group_book_diff, i.e. the groups that
+          *                 have been created or updated and the min_price of the groups that have been removed
+          * @param base_asset symbol or ID of asset being sold
+          * @param quote_asset symbol or ID of asset being purchased
+          * @param group Maximum price diff within each order group, have to be one of configured values
+          *
+          * @note Subscribing again to the same market and group replaces the callback. The number of markets and
+          *       groups per connection is limited by the api-limit-grouped-orders-subscriptions node option.
+          */
+         void subscribe_to_grouped_limit_orders( std::function<void(const variant&)> callback,
+                                                 std::string base_asset,
+                                                 std::string quote_asset,
+                                                 uint16_t group );
+
+         /**
+          * @brief Unsubscribe from changes of the grouped limit orders in given market
+          * @param base_asset symbol or ID of asset being sold
+          * @param quote_asset symbol or ID of asset being purchased
+          * @param group Maximum price diff within each order group
+          */
+         void unsubscribe_from_grouped_limit_orders( std::string base_asset,
+                                                     std::string quote_asset,
+                                                     uint16_t group );
+
       private:
+         void on_grouped_orders_changed( const vector<limit_order_group_book_diff>& diffs );
+
          application& _app;
          graphene::app::database_api database_api;
+         boost::signals2::scoped_connection _grouped_orders_connection;
+         map< limit_order_group_book_key, std::function<void(const variant&)> > _grouped_orders_subscriptions;
    };
 
    /**
@@ -741,6 +773,8 @@ FC_API(graphene::app::asset_api,
 FC_API(graphene::app::orders_api,
        (get_tracked_groups)
        (get_grouped_limit_orders)
+       (subscribe_to_grouped_limit_orders)
+       (unsubscribe_from_grouped_limit_orders)
      )
 FC_API(graphene::app::custom_operations_api,
        (get_storage_info)
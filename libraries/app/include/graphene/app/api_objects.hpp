@@ -162,6 +162,13 @@ namespace graphene { namespace app {
       optional<liquidity_pool_ticker_object> statistics;
    };
 
+   /// An object serialized with fc::raw, the type to unpack it to is identified by the object ID
+   struct packed_object
+   {
+      object_id_type id;
+      vector<char>   data;
+   };
+
 } }
 
 FC_REFLECT( graphene::app::more_data,
@@ -192,6 +199,7 @@ FC_REFLECT( graphene::app::full_account,
           )
 
 FC_REFLECT( graphene::app::order, (price)(quote)(base) )
+FC_REFLECT( graphene::app::packed_object, (id)(data) )
 FC_REFLECT( graphene::app::order_book, (base)(quote)(bids)(asks) )
 FC_REFLECT( graphene::app::market_ticker,
             (time)(base)(quote)(latest)(lowest_ask)(lowest_ask_base_size)(lowest_ask_quote_size)
@@ -39,6 +39,7 @@ namespace graphene { namespace app {
    {
       public:
          bool enable_subscribe_to_all = false;
+         bool enable_api_streams = false;
 
          bool has_api_helper_indexes_plugin = false;
          bool has_market_history_plugin = false;
@@ -77,6 +78,9 @@ namespace graphene { namespace app {
          uint64_t api_limit_get_liquidity_pool_history = 101;
          uint64_t api_limit_get_samet_funds = 101;
          uint64_t api_limit_get_credit_offers = 101;
+         uint64_t api_limit_stream_pages_in_flight = 4;
+         uint64_t api_limit_stream_bytes_in_flight = 4 * 1024 * 1024;
+         uint64_t api_limit_grouped_orders_subscriptions = 10;
 
          static const application_options& get_default()
          {
@@ -92,6 +92,21 @@ class database_api
       fc::variants get_objects( const vector<object_id_type>& ids,
                                 optional<bool> subscribe = optional<bool>() )const;
 
+      /**
+       * @brief Get the objects corresponding to the provided IDs in binary form
+       * @param ids IDs of the objects to retrieve
+       * @param subscribe @a true to subscribe to the queried objects; @a false to not subscribe;
+       *                  @a null to subscribe or not subscribe according to current auto-subscription setting
+       *                  (see @ref set_auto_subscription)
+       * @return The objects retrieved, serialized with fc::raw, in the order they are mentioned in ids
+       *
+       * This is a cheaper alternative to @ref get_objects for clients which are able to unpack the objects
+       * themselves, since the objects don't need to be converted to variants.
+       * If any of the provided IDs does not map to an object, a null is returned in its position.
+       */
+      vector<optional<packed_object>> get_packed_objects( const vector<object_id_type>& ids,
+                                                          optional<bool> subscribe = optional<bool>() )const;
+
       ///////////////////
       // Subscriptions //
       ///////////////////
@@ -148,6 +163,59 @@ class database_api
        */
       void cancel_all_subscriptions();
 
+      /**
+       * @brief Stream all accounts ordered by name, starting from a lower bound
+       * @param callback Callback method which is called with each page of results, and with a null variant
+       *                 after the last page
+       * @param lower_bound_name Lower bound of the first name to return
+       *
+       * Each page is an array of [name, account_id] pairs, containing at most as many entries as
+       * @ref lookup_accounts is allowed to return. Pages are sent one after another without further requests.
+       * The position in the index is kept as a key on the server side, so the scan continues correctly
+       * when new blocks are applied in between.
+       *
+       * Only one stream is active per connection. Starting a new stream cancels the current one.
+       * The client has to acknowledge the pages it has received with @ref ack_stream_pages, the server stops
+       * sending while too many pages or bytes are not acknowledged.
+       *
+       * Streams are only available if the server is started with the enable-api-streams option.
+       *
+       * @see @ref cancel_stream
+       */
+      void stream_accounts( std::function<void(const variant&)> callback, const string& lower_bound_name );
+      /**
+       * @brief Stream the full order book of a market
+       * @param callback Callback method which is called with each page of results, and with a null variant
+       *                 after the last page
+       * @param a symbol or ID of asset being sold
+       * @param b symbol or ID of asset being purchased
+       *
+       * All limit orders selling @p a are sent first, then all limit orders selling @p b, each side ordered by
+       * price from the best to the worst. Each page contains at most as many orders as
+       * @ref get_limit_orders is allowed to return per side.
+       *
+       * Only one stream is active per connection. Starting a new stream cancels the current one.
+       * The client has to acknowledge the pages it has received with @ref ack_stream_pages, the server stops
+       * sending while too many pages or bytes are not acknowledged.
+       *
+       * Streams are only available if the server is started with the enable-api-streams option.
+       *
+       * @see @ref cancel_stream
+       */
+      void stream_limit_orders( std::function<void(const variant&)> callback,
+                                const std::string& a, const std::string& b );
+      /**
+       * @brief Acknowledge pages received from the active stream of this connection
+       * @param count Number of the oldest unacknowledged pages which the client has received
+       *
+       * The stream stops if no pages are acknowledged for a minute while it waits.
+       */
+      void ack_stream_pages( uint32_t count );
+      /**
+       * @brief Stop the active stream of this connection, if any
+       */
+      void cancel_stream();
+
       /////////////////////////////
       // Blocks and transactions //
       /////////////////////////////
@@ -1343,6 +1411,7 @@ extern template class fc::api<graphene::app::database_api>;
 FC_API(graphene::app::database_api,
    // Objects
    (get_objects)
+   (get_packed_objects)
 
    // Subscriptions
    (set_subscribe_callback)
@@ -1350,6 +1419,10 @@ FC_API(graphene::app::database_api,
    (set_pending_transaction_callback)
    (set_block_applied_callback)
    (cancel_all_subscriptions)
+   (stream_accounts)
+   (stream_limit_orders)
+   (ack_stream_pages)
+   (cancel_stream)
 
    // Blocks and transactions
    (get_block_header)
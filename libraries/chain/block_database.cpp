@@ -90,7 +90,7 @@ void block_database::store( const block_id_type& _id, const signed_block& b )
    _block_num_to_pos.seekp( sizeof( index_entry ) * int64_t(block_header::num_from_id(id)) );
    index_entry e;
    _blocks.seekp( 0, _blocks.end );
-   auto vec = fc::raw::pack( b );
+   const auto vec = b.get_packed();
    e.block_pos  = _blocks.tellp();
    e.block_size = vec.size();
    e.block_id   = id;
@@ -149,27 +149,73 @@ block_id_type block_database::fetch_block_id( uint32_t block_num )const
    return e.block_id;
 }
 
-optional<signed_block> block_database::fetch_optional( const block_id_type& id )const
+optional<index_entry> block_database::fetch_index_entry( uint32_t block_num )const
+{
+   index_entry e;
+   int64_t index_pos = sizeof(e) * int64_t(block_num);
+   _block_num_to_pos.seekg( 0, _block_num_to_pos.end );
+   if ( _block_num_to_pos.tellg() <= index_pos )
+      return {};
+
+   _block_num_to_pos.seekg( index_pos, _block_num_to_pos.beg );
+   _block_num_to_pos.read( (char*)&e, sizeof(e) );
+   return e;
+}
+
+vector<char> block_database::read_block_data( const index_entry& e )const
+{
+   vector<char> data( e.block_size.value() );
+   _blocks.seekg( e.block_pos.value() );
+   if( !data.empty() )
+      _blocks.read( data.data(), data.size() );
+   return data;
+}
+
+optional<vector<char>> block_database::fetch_packed_optional( const block_id_type& id )const
 {
    try
    {
-      index_entry e;
-      int64_t index_pos = sizeof(e) * int64_t(block_header::num_from_id(id));
-      _block_num_to_pos.seekg( 0, _block_num_to_pos.end );
-      if ( _block_num_to_pos.tellg() <= index_pos )
+      optional<index_entry> e = fetch_index_entry( block_header::num_from_id(id) );
+      if( !e.valid() || e->block_id != id || e->block_size.value() == 0 )
          return {};
+      return read_block_data( *e );
+   }
+   catch (const fc::exception&)
+   {
+   }
+   catch (const std::exception&)
+   {
+   }
+   return optional<vector<char>>();
+}
 
-      _block_num_to_pos.seekg( index_pos );
-      _block_num_to_pos.read( (char*)&e, sizeof(e) );
-
-      if( e.block_id != id ) return optional<signed_block>();
+optional<vector<char>> block_database::fetch_packed_by_number( uint32_t block_num )const
+{
+   try
+   {
+      optional<index_entry> e = fetch_index_entry( block_num );
+      if( !e.valid() || e->block_size.value() == 0 )
+         return {};
+      return read_block_data( *e );
+   }
+   catch (const fc::exception&)
+   {
+   }
+   catch (const std::exception&)
+   {
+   }
+   return optional<vector<char>>();
+}
 
-      vector<char> data( e.block_size.value() );
-      _blocks.seekg( e.block_pos.value() );
-      if (e.block_size.value())
-         _blocks.read( data.data(), e.block_size.value() );
-      auto result = fc::raw::unpack<signed_block>(data);
-      FC_ASSERT( result.id() == e.block_id );
+optional<signed_block> block_database::fetch_optional( const block_id_type& id )const
+{
+   try
+   {
+      optional<vector<char>> data = fetch_packed_optional( id );
+      if( !data.valid() )
+         return optional<signed_block>();
+      auto result = fc::raw::unpack<signed_block>(*data);
+      FC_ASSERT( result.id() == id );
       return result;
    }
    catch (const fc::exception&)
@@ -185,20 +231,11 @@ optional<signed_block> block_database::fetch_by_number( uint32_t block_num )cons
 {
    try
    {
-      index_entry e;
-      int64_t index_pos = sizeof(e) * int64_t(block_num);
-      _block_num_to_pos.seekg( 0, _block_num_to_pos.end );
-      if ( _block_num_to_pos.tellg() <= index_pos )
+      optional<index_entry> e = fetch_index_entry( block_num );
+      if( !e.valid() )
          return {};
-
-      _block_num_to_pos.seekg( index_pos, _block_num_to_pos.beg );
-      _block_num_to_pos.read( (char*)&e, sizeof(e) );
-
-      vector<char> data( e.block_size.value() );
-      _blocks.seekg( e.block_pos.value() );
-      _blocks.read( data.data(), e.block_size.value() );
-      auto result = fc::raw::unpack<signed_block>(data);
-      FC_ASSERT( result.id() == e.block_id );
+      auto result = fc::raw::unpack<signed_block>( read_block_data( *e ) );
+      FC_ASSERT( result.id() == e->block_id );
       return result;
    }
    catch (const fc::exception&)
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 BitShares Blockchain Foundation, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <graphene/chain/block_tracer.hpp>
+
+#include <fc/io/json.hpp>
+#include <fc/log/logger.hpp>
+#include <fc/variant_object.hpp>
+
+namespace graphene { namespace chain {
+
+void block_tracer::enable( const fc::path& output_dir, uint32_t first_block, uint32_t last_block,
+                           const fc::microseconds& threshold )
+{
+   FC_ASSERT( first_block <= last_block, "Invalid block range" );
+   FC_ASSERT( first_block != 0 || threshold.count() > 0, "Neither a block range nor a threshold is given" );
+   fc::create_directories( output_dir );
+   _output_dir  = output_dir;
+   _first_block = first_block;
+   _last_block  = last_block;
+   _threshold   = threshold;
+   _enabled     = true;
+}
+
+void block_tracer::disable()
+{
+   _enabled = false;
+   _recording = false;
+   _spans.clear();
+}
+
+void block_tracer::start_block( uint32_t block_num )
+{
+   _spans.clear();
+   _recording = _enabled && ( in_range( block_num ) || _threshold.count() > 0 );
+   if( !_recording )
+      return;
+   _block_num = block_num;
+   _block_start = fc::time_point::now();
+}
+
+void block_tracer::add_span( const char* name, const fc::time_point& start, const fc::time_point& end )
+{
+   if( _recording )
+      _spans.push_back( { name, start, end } );
+}
+
+fc::path block_tracer::finish_block( const fc::microseconds& elapsed )
+{
+   if( !_recording )
+      return fc::path();
+   _recording = false;
+   if( !in_range( _block_num ) && ( _threshold.count() <= 0 || elapsed < _threshold ) )
+      return fc::path();
+
+   // Complete events ("ph":"X"), timestamps in microseconds since the block started
+   fc::variants events;
+   events.reserve( _spans.size() + 1 );
+   const auto to_event = [this]( const char* name, const fc::time_point& start, const fc::time_point& end ) {
+      return fc::mutable_variant_object( "name", name )
+                                       ( "cat", "block" )
+                                       ( "ph", "X" )
+                                       ( "ts", ( start - _block_start ).count() )
+                                       ( "dur", ( end - start ).count() )
+                                       ( "pid", 0 )
+                                       ( "tid", 0 );
+   };
+   events.emplace_back( to_event( "apply_block", _block_start, _block_start + elapsed )
+                           ( "args", fc::mutable_variant_object( "block_num", _block_num ) ) );
+   for( const auto& s : _spans )
+      events.emplace_back( to_event( s.name, s.start, s.end ) );
+   _spans.clear();
+
+   const fc::path filename = _output_dir / ( "block-" + std::to_string( _block_num ) + ".json" );
+   try
+   {
+      fc::json::save_to_file( fc::mutable_variant_object( "traceEvents", events )( "displayTimeUnit", "ms" ),
+                              filename );
+   }
+   catch( const fc::exception& e )
+   {
+      wlog( "Failed to write the trace of block ${n}: ${e}", ("n", _block_num)("e", e.to_detail_string()) );
+      return fc::path();
+   }
+   return filename;
+}
+
+} } // graphene::chain
@@ -82,12 +82,35 @@ optional<signed_block> database::fetch_block_by_number( uint32_t num )const
       return _block_id_to_block.fetch_by_number(num);
 }
 
-const signed_transaction& database::get_recent_transaction(const transaction_id_type& trx_id) const
+optional<vector<char>> database::fetch_packed_block_by_id( const block_id_type& id )const
+{
+   auto b = _fork_db.fetch_block( id );
+   if( !b )
+      return _block_id_to_block.fetch_packed_optional(id);
+   return b->data.get_packed();
+}
+
+signed_transaction database::get_recent_transaction(const transaction_id_type& trx_id) const
 {
    auto& index = get_index_type<transaction_index>().indices().get<by_trx_id>();
    auto itr = index.find(trx_id);
    FC_ASSERT(itr != index.end());
-   return itr->trx;
+   if( itr->block_num == 0 )
+   {
+      for( const auto& trx : _pending_tx )
+      {
+         if( trx.id() == trx_id )
+            return trx;
+      }
+   }
+   else
+   {
+      auto block = fetch_block_by_number( itr->block_num );
+      if( block.valid() && itr->trx_in_block < block->transactions.size()
+            && block->transactions[itr->trx_in_block].id() == trx_id )
+         return block->transactions[itr->trx_in_block];
+   }
+   FC_THROW( "Transaction ${id} is known but not available", ("id", trx_id) );
 }
 
 std::vector<block_id_type> database::get_block_ids_on_fork(block_id_type head_of_fork) const
@@ -268,7 +291,8 @@ void database::update_witnesses( fork_item& fork_entry )const
 processed_transaction database::push_transaction( const precomputable_transaction& trx, uint32_t skip )
 { try {
    // see https://github.com/bitshares/bitshares-core/issues/1573
-   FC_ASSERT( fc::raw::pack_size( trx ) < (1024 * 1024), "Transaction exceeds maximum transaction size." );
+   FC_ASSERT( trx.get_packed_signed_transaction()->size() < (1024 * 1024),
+              "Transaction exceeds maximum transaction size." );
    processed_transaction result;
    detail::with_skip_flags( *this, skip, [&]()
    {
@@ -439,7 +463,9 @@ signed_block database::_generate_block(
    uint64_t postponed_tx_count = 0;
    for( const processed_transaction& tx : _pending_tx )
    {
-      size_t new_total_size = total_block_size + fc::raw::pack_size( tx );
+      // same as fc::raw::pack_size( tx ), but the packed signed transaction is cached for the block
+      size_t new_total_size = total_block_size + tx.get_packed_signed_transaction()->size()
+                              + fc::raw::pack_size( tx.operation_results );
 
       // postpone transaction if it would make block too big
       if( new_total_size > maximum_block_size )
@@ -459,7 +485,8 @@ signed_block database::_generate_block(
          // We have to recompute pack_size(ptx) because it may be different
          // than pack_size(tx) (i.e. if one or more results increased
          // their size)
-         new_total_size = total_block_size + fc::raw::pack_size( ptx );
+         new_total_size = total_block_size + ptx.get_packed_signed_transaction()->size()
+                          + fc::raw::pack_size( ptx.operation_results );
          // postpone transaction if it would make block too big
          if( new_total_size > maximum_block_size )
          {
@@ -586,9 +613,18 @@ void database::_apply_block( const signed_block& next_block )
    uint32_t skip = get_node_properties().skip_flags;
    _applied_ops.clear();
 
+   const fc::time_point apply_start = fc::time_point::now();
+   const bool profiling = _profiler.is_enabled();
+   if( profiling )
+      _profiler.start_block( next_block_num );
+   if( _tracer.is_enabled() )
+      _tracer.start_block( next_block_num );
+   block_tracer* const tracer = get_recording_block_tracer();
+   block_tracer::scoped_span stage( tracer, "validate_block_header" );
+
    if( 0 == (skip & skip_block_size_check) )
    {
-      FC_ASSERT( fc::raw::pack_size(next_block) <= get_global_properties().parameters.maximum_block_size );
+      FC_ASSERT( next_block.get_packed_size() <= get_global_properties().parameters.maximum_block_size );
    }
 
    FC_ASSERT( (skip & skip_merkle_check) || next_block.transaction_merkle_root == next_block.calculate_merkle_root(),
@@ -613,42 +649,68 @@ void database::_apply_block( const signed_block& next_block )
 
    _issue_453_affected_assets.clear();
 
+   stage.next( "transactions" );
    signed_block processed_block( next_block ); // make a copy
-   for( auto& trx : processed_block.transactions )
    {
-      /* We do not need to push the undo state for each transaction
-       * because they either all apply and are valid or the
-       * entire block fails to apply.  We only need an "undo" state
-       * for transactions when validating broadcast transactions or
-       * when building a block.
-       */
-      trx.operation_results = apply_transaction( trx, skip ).operation_results;
-      ++_current_trx_in_block;
+      struct applying_block_transactions_guard
+      {
+         bool& flag;
+         explicit applying_block_transactions_guard( bool& f ) : flag(f) { flag = true; }
+         ~applying_block_transactions_guard() { flag = false; }
+      } guard( _applying_block_transactions );
+
+      for( auto& trx : processed_block.transactions )
+      {
+         /* We do not need to push the undo state for each transaction
+          * because they either all apply and are valid or the
+          * entire block fails to apply.  We only need an "undo" state
+          * for transactions when validating broadcast transactions or
+          * when building a block.
+          */
+         block_tracer::scoped_span trx_span( tracer, "transaction" );
+         trx.operation_results = apply_transaction( trx, skip ).operation_results;
+         ++_current_trx_in_block;
+      }
    }
 
    _current_op_in_trx    = 0;
    _current_virtual_op   = 0;
 
+   stage.next( "update_global_dynamic_data" );
    const uint32_t missed = update_witness_missed_blocks( next_block );
    update_global_dynamic_data( next_block, missed );
    update_signing_witness(signing_witness, next_block);
    update_last_irreversible_block();
 
+   stage.next( "process_tickets" );
    process_tickets();
 
    // Are we at the maintenance interval?
    if( maint_needed )
+   {
+      stage.next( "perform_chain_maintenance" );
       perform_chain_maintenance( next_block );
+   }
 
+   stage.next( "create_block_summary" );
    create_block_summary(next_block);
+   stage.next( "clear_expired_transactions" );
    clear_expired_transactions();
+   stage.next( "clear_expired_proposals" );
    clear_expired_proposals();
+   stage.next( "clear_expired_orders" );
    clear_expired_orders();
+   stage.next( "clear_expired_force_settlements" );
    clear_expired_force_settlements();
+   stage.next( "clear_expired_htlcs" );
    clear_expired_htlcs();
+   stage.next( "update_expired_feeds" );
    update_expired_feeds();       // this will update expired feeds and some core exchange rates
+   stage.next( "update_core_exchange_rates" );
    update_core_exchange_rates(); // this will update remaining core exchange rates
+   stage.next( "update_withdraw_permissions" );
    update_withdraw_permissions();
+   stage.next( "update_credit_offers_and_deals" );
    update_credit_offers_and_deals();
 
    // n.b., update_maintenance_flag() happens this late
@@ -656,16 +718,33 @@ void database::_apply_block( const signed_block& next_block )
    // TODO:  figure out if we could collapse this function into
    // update_global_dynamic_data() as perhaps these methods only need
    // to be called for header validation?
+   stage.next( "update_witness_schedule" );
    update_maintenance_flag( maint_needed );
    update_witness_schedule();
    if( !_node_property_object.debug_updates.empty() )
       apply_debug_updates();
 
    // notify observers that the block has been applied
+   stage.next( "applied_block_handlers" );
+   const fc::time_point notify_start = fc::time_point::now();
    notify_applied_block( processed_block ); //emit
    _applied_ops.clear();
 
+   stage.next( "notify_changed_objects" );
+   const fc::time_point notify_objects_start = fc::time_point::now();
    notify_changed_objects();
+
+   stage.end();
+   const fc::time_point apply_end = fc::time_point::now();
+   ++_block_processing_counters.blocks;
+   _block_processing_counters.apply_time += ( apply_end - apply_start ).count();
+   _block_processing_counters.applied_block_handlers_time += ( notify_objects_start - notify_start ).count();
+   _block_processing_counters.object_handlers_time += ( apply_end - notify_objects_start ).count();
+
+   if( profiling )
+      _profiler.finish_block( static_cast<uint32_t>( next_block.transactions.size() ), apply_end - apply_start );
+   if( tracer )
+      tracer->finish_block( apply_end - apply_start );
 } FC_CAPTURE_AND_RETHROW( (next_block.block_num()) )  }
 
 /**
@@ -676,10 +755,15 @@ void database::_apply_block( const signed_block& next_block )
 processed_transaction database::apply_transaction(const signed_transaction& trx, uint32_t skip)
 {
    processed_transaction result;
+   const bool profiling = _profiler.is_enabled();
+   const fc::time_point start = profiling ? fc::time_point::now() : fc::time_point();
    detail::with_skip_flags( *this, skip, [&]()
    {
       result = _apply_transaction(trx);
    });
+   if( profiling )
+      _profiler.record_transaction( trx, _applying_block_transactions ? _current_block_num : 0,
+                                    fc::time_point::now() - start );
    return result;
 }
 
@@ -742,9 +826,14 @@ processed_transaction database::_apply_transaction(const signed_transaction& trx
    //Insert transaction into unique transactions database.
    if( 0 == (skip & skip_transaction_dupe_check) )
    {
-      create<transaction_history_object>([&trx](transaction_history_object& transaction) {
+      create<transaction_history_object>([this,&trx](transaction_history_object& transaction) {
          transaction.trx_id = trx.id();
-         transaction.trx = trx;
+         transaction.expiration = trx.expiration;
+         if( _applying_block_transactions )
+         {
+            transaction.block_num = _current_block_num;
+            transaction.trx_in_block = _current_trx_in_block;
+         }
       });
    }
 
@@ -778,6 +867,7 @@ operation_result database::apply_operation(transaction_evaluation_state& eval_st
    unique_ptr<op_evaluator>& eval = _operation_evaluators[ u_which ];
    FC_ASSERT( eval, "No registered evaluator for operation ${op}", ("op",op) );
    auto op_id = push_applied_operation( op );
+   execution_profiler::scoped_timer timer( get_enabled_execution_profiler(), i_which, execution_profiler::phase::total );
    auto result = eval->evaluate( eval_state, op, true );
    set_applied_operation_result( op_id, result );
    return result;
@@ -299,6 +299,10 @@ void database::init_genesis(const genesis_state_type& genesis_state)
           op.upgrade_to_lifetime_member = true;
           apply_operation(genesis_eval_state, op);
       }
+
+      // Genesis operations are not part of any block and nobody reads their history, so do not let millions of
+      // them pile up until the first block is applied
+      _applied_ops.clear();
    }
 
    // Helper function to get account ID by name
@@ -568,6 +572,7 @@ void database::init_genesis(const genesis_state_type& genesis_state)
 
    //debug_dump(); // for debug
 
+   _applied_ops.clear();
    _undo_db.enable();
 } FC_CAPTURE_AND_RETHROW() }
 
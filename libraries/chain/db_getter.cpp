@@ -32,6 +32,8 @@
 #include <graphene/chain/market_object.hpp>
 #include <graphene/chain/custom_authority_object.hpp>
 
+#include <boost/range/iterator_range.hpp>
+
 namespace graphene { namespace chain {
 
 const asset_object& database::get_core_asset() const
@@ -106,21 +108,22 @@ vector<authority> database::get_viable_custom_authorities(
    const auto& index = get_index_type<custom_authority_index>().indices().get<by_account_custom>();
    auto range = index.equal_range(boost::make_tuple(account, unsigned_int(op.which()), true));
 
-   auto is_valid = [now=head_block_time()](const custom_authority_object& auth) { return auth.is_valid(now); };
-   vector<std::reference_wrapper<const custom_authority_object>> valid_auths;
-   std::copy_if(range.first, range.second, std::back_inserter(valid_auths), is_valid);
-
+   // The index only yields the enabled authorities of the account for this operation type, the rest are never
+   // evaluated
+   const auto now = head_block_time();
    vector<authority> results;
-   for (const auto& cust_auth : valid_auths) {
+   for (const custom_authority_object& cust_auth : boost::make_iterator_range(range.first, range.second)) {
+      if (!cust_auth.is_valid(now))
+         continue;
       try {
-         auto result = cust_auth.get().get_predicate()(op);
+         auto result = cust_auth.get_predicate()(op);
          if (result.success)
-            results.emplace_back(cust_auth.get().auth);
+            results.emplace_back(cust_auth.auth);
          else if (rejected_authorities != nullptr)
-            rejected_authorities->insert(std::make_pair(cust_auth.get().id, std::move(result)));
+            rejected_authorities->insert(std::make_pair(cust_auth.id, std::move(result)));
       } catch (fc::exception& e) {
          if (rejected_authorities != nullptr)
-            rejected_authorities->insert(std::make_pair(cust_auth.get().id, std::move(e)));
+            rejected_authorities->insert(std::make_pair(cust_auth.id, std::move(e)));
       }
    }
 
@@ -154,13 +154,14 @@ void database::initialize_indexes()
 
    //Protocol object indexes
    add_index< primary_index<asset_index, 13> >(); // 8192 assets per chunk
-   add_index< primary_index<force_settlement_index> >();
+   add_index< primary_index<force_settlement_index> >()->add_secondary_index<force_settlement_schedule_index>();
 
    add_index< primary_index<account_index, 20> >(); // ~1 million accounts per chunk
    add_index< primary_index<committee_member_index, 8> >(); // 256 members per chunk
    add_index< primary_index<witness_index, 10> >(); // 1024 witnesses per chunk
-   add_index< primary_index<limit_order_index > >();
-   add_index< primary_index<call_order_index > >();
+   // orders come and go, their ids are sparse soon after the start of the chain
+   add_index< primary_index<limit_order_index > >()->use_hash_index();
+   add_index< primary_index<call_order_index > >()->use_hash_index();
    add_index< primary_index<proposal_index > >();
    add_index< primary_index<withdraw_permission_index > >();
    add_index< primary_index<vesting_balance_index> >();
@@ -180,6 +181,7 @@ void database::initialize_indexes()
 
    auto bal_idx = add_index< primary_index<account_balance_index          > >();
    bal_idx->add_secondary_index<balances_by_account_index>();
+   bal_idx->use_hash_index();
 
    add_index< primary_index<asset_bitasset_data_index,                 13 > >(); // 8192
    add_index< primary_index<simple_index<global_property_object          >> >();
@@ -1459,6 +1459,7 @@ void database::perform_chain_maintenance( const signed_block& next_block )
 
    vote_tally_helper tally_helper(*this);
 
+   block_tracer::scoped_span stage( get_recording_block_tracer(), "perform_account_maintenance" );
    perform_account_maintenance( tally_helper );
 
    struct clear_canary {
@@ -1472,11 +1473,13 @@ void database::perform_chain_maintenance( const signed_block& next_block )
    clear_canary b(_committee_count_histogram_buffer);
    clear_canary c(_vote_tally_buffer);
 
+   stage.next( "update_active_authorities" );
    update_top_n_authorities(*this);
    update_active_witnesses();
    update_active_committee_members();
    update_worker_votes();
 
+   stage.next( "update_global_properties" );
    modify(gpo, [&dgpo](global_property_object& p) {
       // Remove scaling of account registration fee
       p.parameters.get_mutable_fees().get<account_create_operation>().basic_fee >>=
@@ -1586,11 +1589,13 @@ void database::perform_chain_maintenance( const signed_block& next_block )
       match_call_orders(*this);
    }
 
+   stage.next( "process_bitassets" );
    process_bitassets();
    delete_expired_custom_auths(*this);
 
    // process_budget needs to run at the bottom because
    //   it needs to know the next_maintenance_time
+   stage.next( "process_budget" );
    process_budget();
 }
 
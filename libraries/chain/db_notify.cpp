@@ -524,12 +524,9 @@ static void get_relevant_accounts( const object* obj, flat_set<account_id_type>&
               const auto* aobj = dynamic_cast<const account_statistics_object*>(obj);
               accounts.insert( aobj->owner );
               break;
-           } case impl_transaction_history_object_type:{
-              const auto* aobj = dynamic_cast<const transaction_history_object*>(obj);
-              transaction_get_impacted_accs( aobj->trx, accounts,
-                                             ignore_custom_op_required_auths );
+           } case impl_transaction_history_object_type:
               break;
-           } case impl_blinded_balance_object_type:{
+             case impl_blinded_balance_object_type:{
               const auto* aobj = dynamic_cast<const blinded_balance_object*>(obj);
               for( const auto& a : aobj->owner.account_auths )
                 accounts.insert( a.first );
@@ -641,6 +638,8 @@ void database::notify_changed_objects()
            GRAPHENE_TRY_NOTIFY( removed_objects, removed_ids, removed, removed_accounts_impacted )
       }
    }
+
+   GRAPHENE_TRY_NOTIFY( changed_objects_notified )
 } catch( const graphene::chain::plugin_exception& e ) {
    elog( "Caught plugin exception: ${e}", ("e", e.to_detail_string() ) );
    throw;
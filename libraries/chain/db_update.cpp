@@ -148,7 +148,7 @@ void database::clear_expired_transactions()
    auto& transaction_idx = static_cast<transaction_index&>(get_mutable_index(implementation_ids,
                                                                              impl_transaction_history_object_type));
    const auto& dedupe_index = transaction_idx.indices().get<by_expiration>();
-   while( (!dedupe_index.empty()) && (head_block_time() > dedupe_index.begin()->trx.expiration) )
+   while( (!dedupe_index.empty()) && (head_block_time() > dedupe_index.begin()->expiration) )
       transaction_idx.remove(*dedupe_index.begin());
 } FC_CAPTURE_AND_RETHROW() }
 
@@ -295,24 +295,42 @@ void database::clear_expired_force_settlements()
 { try {
    // Process expired force settlement orders
 
-   // TODO Possible performance optimization. Looping through all assets is not ideal.
-   //      - One idea is to check time first, if any expired settlement found, check asset.
-   //        However, due to max_settlement_volume, this does not work, i.e. time meets but have to
-   //        skip due to volume limit.
-   //      - Instead, maintain some data e.g. (whether_force_settle_volome_meets, first_settle_time)
-   //        in bitasset_data object and index by them, then we could process here faster.
-   //        Note: due to rounding, even when settled < max_volume, it is still possible that we have to skip
+   // Only the assets which have a due settle order or have been globally settled need to be visited,
+   //   settle orders of other assets would be skipped without any change.
+   // Note: due to max_settlement_volume, even a visited asset may have to be skipped.
    const auto& settlement_index = get_index_type<force_settlement_index>().indices().get<by_expiration>();
    if( settlement_index.empty() )
       return;
 
    const auto& head_time = head_block_time();
+
+   const auto& dates_by_asset = get_index_type< primary_index<force_settlement_index> >()
+                                   .get_secondary_index<force_settlement_schedule_index>()
+                                   .get_dates_by_asset();
+
+   // Find the first asset after the given one that has settle orders and needs to be visited.
+   // Note: globally settled assets are checked every time, because processing an asset may globally settle
+   //       another one, in which case its settle orders are to be cancelled in this block.
+   auto find_next_asset = [&dates_by_asset, &head_time, this]( const optional<asset_id_type>& after ) {
+      auto itr = after.valid() ? dates_by_asset.upper_bound( *after ) : dates_by_asset.begin();
+      for( ; itr != dates_by_asset.end(); ++itr )
+      {
+         if( *itr->second.begin() <= head_time || get( itr->first ).bitasset_data( *this ).has_settlement() )
+            return optional<asset_id_type>( itr->first );
+      }
+      return optional<asset_id_type>();
+   };
+
+   optional<asset_id_type> first_asset = find_next_asset( optional<asset_id_type>() );
+   if( !first_asset.valid() )
+      return;
+
    const auto& maint_time = get_dynamic_global_properties().next_maintenance_time;
 
    const bool before_core_hardfork_184 = ( maint_time <= HARDFORK_CORE_184_TIME ); // something-for-nothing
    const bool before_core_hardfork_342 = ( maint_time <= HARDFORK_CORE_342_TIME ); // better rounding
 
-   asset_id_type current_asset = settlement_index.begin()->settlement_asset_id();
+   asset_id_type current_asset = *first_asset;
    const asset_object* mia_object_ptr = &get(current_asset);
    const asset_bitasset_data_object* mia_ptr = &mia_object_ptr->bitasset_data(*this);
 
@@ -321,11 +339,11 @@ void database::clear_expired_force_settlements()
    price settlement_price;
    bool current_asset_finished = false;
 
-   auto next_asset = [&current_asset, &mia_object_ptr, &mia_ptr, &current_asset_finished, &settlement_index, this] {
-      const auto bound = settlement_index.upper_bound(current_asset);
-      if( bound == settlement_index.end() )
+   auto next_asset = [&current_asset, &mia_object_ptr, &mia_ptr, &current_asset_finished, &find_next_asset, this] {
+      const auto next = find_next_asset( current_asset );
+      if( !next.valid() )
          return false;
-      current_asset = bound->settlement_asset_id();
+      current_asset = *next;
       mia_object_ptr = &get(current_asset);
       mia_ptr = &mia_object_ptr->bitasset_data(*this);
       current_asset_finished = false;
@@ -340,13 +358,12 @@ void database::clear_expired_force_settlements()
       const force_settlement_object& settle_order = *itr;
       auto settle_order_id = settle_order.id;
 
+      // No more settle orders of the current asset
       if( current_asset != settle_order.settlement_asset_id() )
       {
-         current_asset = settle_order.settlement_asset_id();
-         mia_object_ptr = &get(current_asset);
-         mia_ptr = &mia_object_ptr->bitasset_data(*this);
-         // Note: we did not reset current_asset_finished to false here, it is OK,
-         //       because current_asset should not have changed if current_asset_finished is true
+         if( next_asset() )
+            continue;
+         break;
       }
       const asset_object& mia_object = *mia_object_ptr;
       const asset_bitasset_data_object& mia = *mia_ptr;
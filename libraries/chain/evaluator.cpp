@@ -41,6 +41,7 @@ database& generic_evaluator::db()const { return trx_state->db(); }
    operation_result generic_evaluator::start_evaluate( transaction_evaluation_state& eval_state, const operation& op, bool apply )
    { try {
       trx_state   = &eval_state;
+      profiler    = db().get_enabled_execution_profiler();
       //check_required_authorities(op);
       auto result = evaluate( op );
 
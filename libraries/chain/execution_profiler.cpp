@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026 BitShares Blockchain Foundation, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <graphene/chain/execution_profiler.hpp>
+
+#include <graphene/db/object_database.hpp>
+#include <graphene/protocol/operations.hpp>
+
+#include <fc/io/json.hpp>
+
+#include <algorithm>
+
+namespace graphene { namespace chain {
+
+namespace {
+
+   struct operation_name_visitor
+   {
+      typedef string result_type;
+
+      template<typename Type>
+      result_type operator()( const Type& )const
+      {
+         string name = fc::get_typename<Type>::name();
+         size_t p = name.rfind(':');
+         if( p != string::npos )
+            name = name.substr( p+1 );
+         return name;
+      }
+   };
+
+} // anonymous namespace
+
+class execution_profiler::object_change_counter : public graphene::db::index_observer
+{
+   public:
+      explicit object_change_counter( execution_profiler& profiler ) : _profiler( profiler ) {}
+
+      virtual void on_add( const graphene::db::object& obj ) override
+      { _profiler.record_object_change( obj.id, &index_change_counts::created ); }
+      virtual void on_remove( const graphene::db::object& obj ) override
+      { _profiler.record_object_change( obj.id, &index_change_counts::removed ); }
+      virtual void on_modify( const graphene::db::object& obj ) override
+      { _profiler.record_object_change( obj.id, &index_change_counts::modified ); }
+
+   private:
+      execution_profiler& _profiler;
+};
+
+constexpr size_t execution_time_histogram::bucket_count;
+constexpr size_t execution_profiler::max_recent_blocks;
+constexpr size_t execution_profiler::max_slowest_transactions;
+
+void execution_time_histogram::add( const fc::microseconds& elapsed )
+{
+   const uint64_t us = static_cast<uint64_t>( std::max<int64_t>( elapsed.count(), 0 ) );
+   if( buckets.empty() )
+      buckets.resize( bucket_count );
+   size_t bucket = 0;
+   while( bucket + 1 < bucket_count && ( uint64_t(1) << bucket ) <= us )
+      ++bucket;
+   ++buckets[bucket];
+   ++count;
+   total += us;
+   max = std::max( max, us );
+}
+
+execution_profiler::execution_profiler() = default;
+execution_profiler::~execution_profiler() = default;
+
+void execution_profiler::enable( bool enabled, graphene::db::object_database& db )
+{
+   if( enabled )
+   {
+      _operations.clear();
+      _recent_blocks.clear();
+      _slowest_transactions.clear();
+      _current_block_changes.clear();
+      _in_block = false;
+      _started = fc::time_point::now();
+      // Indexes do not support removing observers, so the observer is only added once and stays idle
+      // while the profiler is disabled
+      if( !_observer )
+      {
+         _observer = std::make_shared<object_change_counter>( *this );
+         db.add_index_observer( _observer );
+      }
+   }
+   _enabled = enabled;
+}
+
+void execution_profiler::record_operation( int64_t operation_type, phase p, const fc::microseconds& elapsed )
+{
+   if( operation_type < 0 )
+      return;
+   if( _operations.size() <= static_cast<uint64_t>( operation_type ) )
+      _operations.resize( operation_type + 1 );
+   auto& profile = _operations[operation_type];
+   switch( p )
+   {
+      case phase::total:
+         profile.total.add( elapsed );
+         break;
+      case phase::fee_check:
+         profile.fee_check.add( elapsed );
+         break;
+      case phase::evaluate:
+         profile.evaluate.add( elapsed );
+         break;
+      case phase::fee_payment:
+         profile.fee_payment.add( elapsed );
+         break;
+      case phase::apply:
+         profile.apply.add( elapsed );
+         break;
+   }
+}
+
+void execution_profiler::record_transaction( const signed_transaction& trx, uint32_t block_num,
+                                             const fc::microseconds& elapsed )
+{
+   if( _slowest_transactions.size() >= max_slowest_transactions
+         && _slowest_transactions.back().apply_time >= elapsed.count() )
+      return;
+
+   transaction_execution_profile profile;
+   profile.trx_id = trx.id();
+   profile.block_num = block_num;
+   profile.operations = static_cast<uint32_t>( trx.operations.size() );
+   profile.apply_time = elapsed.count();
+
+   auto itr = std::upper_bound( _slowest_transactions.begin(), _slowest_transactions.end(), profile,
+                                []( const transaction_execution_profile& a, const transaction_execution_profile& b ) {
+                                   return a.apply_time > b.apply_time;
+                                } );
+   _slowest_transactions.insert( itr, std::move( profile ) );
+   if( _slowest_transactions.size() > max_slowest_transactions )
+      _slowest_transactions.pop_back();
+}
+
+void execution_profiler::start_block( uint32_t block_num )
+{
+   _current_block = block_execution_profile();
+   _current_block.block_num = block_num;
+   _current_block_changes.clear();
+   _in_block = true;
+}
+
+void execution_profiler::finish_block( uint32_t transactions, const fc::microseconds& elapsed )
+{
+   if( !_in_block )
+      return;
+   _in_block = false;
+
+   _current_block.transactions = transactions;
+   _current_block.apply_time = elapsed.count();
+   _current_block.object_changes.reserve( _current_block_changes.size() );
+   for( const auto& changes : _current_block_changes )
+      _current_block.object_changes.push_back( changes.second );
+   _current_block_changes.clear();
+
+   _recent_blocks.push_back( std::move( _current_block ) );
+   if( _recent_blocks.size() > max_recent_blocks )
+      _recent_blocks.pop_front();
+}
+
+void execution_profiler::record_object_change( const object_id_type& id, uint64_t index_change_counts::* counter )
+{
+   if( !_enabled || !_in_block )
+      return;
+   const uint16_t key = static_cast<uint16_t>( ( uint16_t( id.space() ) << 8 ) | id.type() );
+   auto itr = _current_block_changes.find( key );
+   if( itr == _current_block_changes.end() )
+   {
+      index_change_counts counts;
+      counts.space_id = id.space();
+      counts.type_id = id.type();
+      itr = _current_block_changes.emplace( key, counts ).first;
+   }
+   ++( itr->second.*counter );
+}
+
+execution_profile execution_profiler::get_profile()const
+{
+   execution_profile result;
+   result.started = _started;
+
+   operation op;
+   for( size_t i = 0; i < _operations.size(); ++i )
+   {
+      if( 0 == _operations[i].total.count && 0 == _operations[i].evaluate.count )
+         continue;
+      result.operations.push_back( _operations[i] );
+      result.operations.back().operation_type = static_cast<int64_t>( i );
+      if( static_cast<int64_t>( i ) < op.count() )
+      {
+         op.set_which( i );
+         result.operations.back().operation_name = op.visit( operation_name_visitor() );
+      }
+   }
+
+   result.recent_blocks.assign( _recent_blocks.begin(), _recent_blocks.end() );
+   result.slowest_transactions = _slowest_transactions;
+   return result;
+}
+
+void execution_profiler::dump_profile( const fc::path& filename )const
+{
+   fc::json::save_to_file( get_profile(), filename );
+}
+
+} } // graphene::chain
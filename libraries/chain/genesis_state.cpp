@@ -26,9 +26,55 @@
 #include <graphene/protocol/fee_schedule.hpp>
 
 #include <fc/io/raw.hpp>
+#include <fc/thread/parallel.hpp>
 
 namespace graphene { namespace chain {
 
+namespace {
+
+/// Converts the elements of an array in chunks distributed over the thread pool
+template<typename T>
+void from_variants_parallel( const fc::variants& vars, vector<T>& result, uint32_t max_depth )
+{
+   // Below this many elements per chunk the overhead of the workers is not worth it
+   constexpr size_t min_chunk_size = 1000;
+
+   result.resize( vars.size() );
+   const size_t threads = fc::asio::default_io_service_scope::get_num_threads();
+   const size_t chunk_size = std::max( min_chunk_size, ( vars.size() + threads - 1 ) / threads );
+   if( vars.size() <= chunk_size )
+   {
+      for( size_t i = 0; i < vars.size(); ++i )
+         fc::from_variant( vars[i], result[i], max_depth );
+      return;
+   }
+
+   std::vector<fc::future<void>> workers;
+   workers.reserve( threads );
+   for( size_t base = 0; base < vars.size(); base += chunk_size )
+      workers.push_back( fc::do_parallel( [&vars,&result,base,chunk_size,max_depth] () {
+         const size_t end = std::min( base + chunk_size, vars.size() );
+         for( size_t i = base; i < end; ++i )
+            fc::from_variant( vars[i], result[i], max_depth );
+      }) );
+
+   // All workers must be done with the arrays before an error is passed on
+   std::exception_ptr error;
+   for( auto& worker : workers )
+   {
+      try {
+         worker.wait();
+      } catch( ... ) {
+         if( !error )
+            error = std::current_exception();
+      }
+   }
+   if( error )
+      std::rethrow_exception( error );
+}
+
+} // anonymous namespace
+
 chain_id_type genesis_state_type::compute_chain_id() const
 {
    return initial_chain_id;
@@ -43,6 +89,39 @@ void genesis_state_type::override_witness_signing_keys( const std::string& new_k
    }
 }
 
+genesis_state_type genesis_state_type::from_variant_parallel( const fc::variant& var, uint32_t max_depth )
+{ try {
+   // The depth of the elements of the lists, which are members of the genesis state
+   FC_ASSERT( max_depth > 2, "Recursion depth exceeded!" );
+   const uint32_t element_depth = max_depth - 2;
+
+   // Copy only the members that are not converted in parallel, the large lists are read in place
+   const fc::variant_object& obj = var.get_object();
+   fc::mutable_variant_object rest;
+   rest.reserve( obj.size() );
+   for( const auto& entry : obj )
+   {
+      const string& key = entry.key();
+      if( key != "initial_accounts" && key != "initial_balances" && key != "initial_vesting_balances" )
+         rest( key, entry.value() );
+   }
+
+   genesis_state_type result;
+   fc::from_variant( fc::variant( std::move( rest ) ), result, max_depth );
+
+   auto itr = obj.find( "initial_accounts" );
+   if( itr != obj.end() )
+      from_variants_parallel( itr->value().get_array(), result.initial_accounts, element_depth );
+   itr = obj.find( "initial_balances" );
+   if( itr != obj.end() )
+      from_variants_parallel( itr->value().get_array(), result.initial_balances, element_depth );
+   itr = obj.find( "initial_vesting_balances" );
+   if( itr != obj.end() )
+      from_variants_parallel( itr->value().get_array(), result.initial_vesting_balances, element_depth );
+
+   return result;
+} FC_CAPTURE_AND_RETHROW() }
+
 } } // graphene::chain
 
 FC_REFLECT_DERIVED_NO_TYPENAME(graphene::chain::genesis_state_type::initial_account_type, BOOST_PP_SEQ_NIL,
@@ -46,12 +46,18 @@ namespace graphene { namespace chain {
          block_id_type          fetch_block_id( uint32_t block_num )const;
          optional<signed_block> fetch_optional( const block_id_type& id )const;
          optional<signed_block> fetch_by_number( uint32_t block_num )const;
+         /// Fetch a block as it is stored, i.e. packed with fc::raw, without unpacking and verifying it
+         optional<vector<char>> fetch_packed_optional( const block_id_type& id )const;
+         /// Fetch a block as it is stored, i.e. packed with fc::raw, without unpacking and verifying it
+         optional<vector<char>> fetch_packed_by_number( uint32_t block_num )const;
          optional<signed_block> last()const;
          optional<block_id_type> last_id()const;
          size_t                 blocks_current_position()const;
          size_t                 total_block_size()const;
       private:
          optional<index_entry> last_index_entry()const;
+         optional<index_entry> fetch_index_entry( uint32_t block_num )const;
+         vector<char> read_block_data( const index_entry& e )const;
          fc::path _index_filename;
          mutable std::fstream _blocks;
          mutable std::fstream _block_num_to_pos;
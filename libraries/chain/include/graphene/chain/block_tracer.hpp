@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 BitShares Blockchain Foundation, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <fc/filesystem.hpp>
+#include <fc/time.hpp>
+
+#include <vector>
+
+namespace graphene { namespace chain {
+
+   /**
+    * @brief Records the stages of block processing as a timeline in the Chrome trace format
+    *
+    * The traces can be opened in chrome://tracing or https://ui.perfetto.dev. One file named
+    * <tt>block-NUM.json</tt> is written for each block in the configured range, and for each block which
+    * took at least the configured threshold to apply.
+    *
+    * The tracer is disabled by default. Spans check a null pointer only while the tracer is not recording.
+    */
+   class block_tracer
+   {
+      public:
+         /**
+          * Measures consecutive spans in its scope, each of them ends when the next one starts.
+          * Spans nest by time, so a span opened inside another one is shown below it.
+          * @note @p name must outlive the tracer, i.e. be a string literal
+          */
+         class scoped_span
+         {
+            public:
+               scoped_span( block_tracer* tracer, const char* name )
+               : _tracer( tracer ), _name( name )
+               {
+                  if( _tracer )
+                     _start = fc::time_point::now();
+               }
+               ~scoped_span()
+               {
+                  if( _tracer )
+                     _tracer->add_span( _name, _start, fc::time_point::now() );
+               }
+               /// End the current span and start another one
+               void next( const char* name )
+               {
+                  if( _tracer )
+                  {
+                     const fc::time_point now = fc::time_point::now();
+                     _tracer->add_span( _name, _start, now );
+                     _start = now;
+                  }
+                  _name = name;
+               }
+               /// End the current span before leaving the scope
+               void end()
+               {
+                  if( _tracer )
+                     _tracer->add_span( _name, _start, fc::time_point::now() );
+                  _tracer = nullptr;
+               }
+
+               scoped_span( const scoped_span& ) = delete;
+               scoped_span& operator=( const scoped_span& ) = delete;
+            private:
+               block_tracer*   _tracer;
+               const char*     _name;
+               fc::time_point  _start;
+         };
+
+         /**
+          * Enable the tracer
+          * @param output_dir directory to write the traces to, created if it does not exist
+          * @param first_block first block to trace, 0 to trace no range
+          * @param last_block last block to trace
+          * @param threshold also trace the blocks taking at least this long to apply, 0 to disable
+          */
+         void enable( const fc::path& output_dir, uint32_t first_block, uint32_t last_block,
+                      const fc::microseconds& threshold );
+         void disable();
+         bool is_enabled()const { return _enabled; }
+         /// @return true between @ref start_block and @ref finish_block of a block which may be written
+         bool is_recording()const { return _recording; }
+
+         void start_block( uint32_t block_num );
+         /// @return the path of the trace if one was written for this block, otherwise an empty path
+         fc::path finish_block( const fc::microseconds& elapsed );
+
+         void add_span( const char* name, const fc::time_point& start, const fc::time_point& end );
+
+      private:
+         struct span
+         {
+            const char*     name;
+            fc::time_point  start;
+            fc::time_point  end;
+         };
+
+         bool in_range( uint32_t block_num )const
+         { return _first_block != 0 && block_num >= _first_block && block_num <= _last_block; }
+
+         bool               _enabled = false;
+         bool               _recording = false;
+         fc::path           _output_dir;
+         uint32_t           _first_block = 0;
+         uint32_t           _last_block = 0;
+         fc::microseconds   _threshold;
+         uint32_t           _block_num = 0;
+         fc::time_point     _block_start;
+         std::vector<span>  _spans;
+   };
+
+} } // graphene::chain
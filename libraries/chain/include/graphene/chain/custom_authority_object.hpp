@@ -37,9 +37,10 @@ namespace graphene { namespace chain {
     *
     */
    class custom_authority_object : public abstract_object<custom_authority_object> {
-      /// Unreflected field to store a cache of the predicate function
+      /// Unreflected field to store a cache of the predicate function, shared with other custom authorities which
+      /// have identical restrictions for the same operation type
       /// Note that this cache can be modified when the object is const!
-      mutable optional<restriction_predicate_function> predicate_cache;
+      mutable std::shared_ptr<const restriction_predicate_function> predicate_cache;
 
    public:
       static constexpr uint8_t space_id = protocol_ids;
@@ -65,15 +66,15 @@ namespace graphene { namespace chain {
          return rs;
       }
       /// Get predicate, from cache if possible, and update cache if not (modifies const object!)
-      restriction_predicate_function get_predicate() const {
-         if (!predicate_cache.valid())
+      const restriction_predicate_function& get_predicate() const {
+         if (!predicate_cache)
             update_predicate_cache();
 
          return *predicate_cache;
       }
       /// Regenerate predicate function and update predicate cache
       void update_predicate_cache() const {
-         predicate_cache = get_restriction_predicate(get_restrictions(), operation_type);
+         predicate_cache = get_shared_restriction_predicate(get_restrictions(), operation_type);
       }
       /// Clear the cache of the predicate function
       void clear_predicate_cache() { predicate_cache.reset(); }
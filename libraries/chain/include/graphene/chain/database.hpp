@@ -33,6 +33,8 @@
 #include <graphene/chain/block_database.hpp>
 #include <graphene/chain/genesis_state.hpp>
 #include <graphene/chain/evaluator.hpp>
+#include <graphene/chain/block_tracer.hpp>
+#include <graphene/chain/execution_profiler.hpp>
 
 #include <graphene/db/object_database.hpp>
 #include <graphene/db/object.hpp>
@@ -545,7 +547,10 @@ namespace graphene { namespace chain {
          block_id_type              get_block_id_for_num( uint32_t block_num )const;
          optional<signed_block>     fetch_block_by_id( const block_id_type& id )const;
          optional<signed_block>     fetch_block_by_number( uint32_t num )const;
-         const signed_transaction&  get_recent_transaction( const transaction_id_type& trx_id )const;
+         /// Fetch a block packed with fc::raw, without unpacking it if it is taken from the block database
+         optional<vector<char>>     fetch_packed_block_by_id( const block_id_type& id )const;
+         /// Fetch a transaction that is in the deduplication index, from its block or the pending transactions
+         signed_transaction         get_recent_transaction( const transaction_id_type& trx_id )const;
          std::vector<block_id_type> get_block_ids_on_fork(block_id_type head_of_fork) const;
 
          void                       add_checkpoints( const flat_map<uint32_t,block_id_type>& checkpts );
@@ -626,6 +631,12 @@ namespace graphene { namespace chain {
          fc::signal<void(const vector<object_id_type>&,
                          const vector<const object*>&, const flat_set<account_id_type>&)>  removed_objects;
 
+         /**
+          *  Emitted after the new_objects, changed_objects and removed_objects signals of a block, also when
+          *  none of them was emitted.  The callback should not yield and should execute quickly.
+          */
+         fc::signal<void()>                              changed_objects_notified;
+
          ///@{
          /**
           *  This method validates transactions without adding it to the pending state.
@@ -772,6 +783,8 @@ namespace graphene { namespace chain {
          uint16_t                          _current_trx_in_block = 0;
          uint16_t                          _current_op_in_trx    = 0;
          uint32_t                          _current_virtual_op   = 0;
+         /// whether the transactions being applied are those of the block @ref _current_block_num
+         bool                              _applying_block_transactions = false;
 
          vector<uint64_t>                  _vote_tally_buffer;
          vector<uint64_t>                  _witness_count_histogram_buffer;
@@ -799,6 +812,12 @@ namespace graphene { namespace chain {
          // Counts nested proposal updates
          uint32_t                          _push_proposal_nesting_depth = 0;
 
+         /// Collects execution statistics when enabled
+         execution_profiler                _profiler;
+
+         /// Writes timelines of block processing when enabled
+         block_tracer                      _tracer;
+
          /// Tracks assets affected by bitshares-core issue #453 before hard fork #615 in one block
          flat_set<asset_id_type>           _issue_453_affected_assets;
 
@@ -814,6 +833,31 @@ namespace graphene { namespace chain {
       public:
          /// Enable or disable tracking of votes of standby witnesses and committee members
          inline void enable_standby_votes_tracking(bool enable)  { _track_standby_votes = enable; }
+
+         /// Enable or disable the execution profiler, enabling it discards the data collected so far
+         void enable_execution_profiler( bool enable ) { _profiler.enable( enable, *this ); }
+         const execution_profiler& get_execution_profiler()const { return _profiler; }
+         /// @return the execution profiler if it is enabled, otherwise nullptr
+         execution_profiler* get_enabled_execution_profiler()
+         { return _profiler.is_enabled() ? &_profiler : nullptr; }
+
+         block_tracer& get_block_tracer() { return _tracer; }
+         /// @return the block tracer while it is recording a block, otherwise nullptr
+         block_tracer* get_recording_block_tracer()
+         { return _tracer.is_recording() ? &_tracer : nullptr; }
+
+         /// Cumulative timing of the blocks applied since the database was created, for monitoring
+         struct block_processing_counters
+         {
+            uint64_t blocks = 0;
+            uint64_t apply_time = 0;                  ///< In microseconds, the whole block
+            uint64_t applied_block_handlers_time = 0; ///< In microseconds, spent in @ref applied_block handlers
+            uint64_t object_handlers_time = 0;        ///< In microseconds, spent in new/changed/removed object handlers
+         };
+         const block_processing_counters& get_block_processing_counters()const { return _block_processing_counters; }
+         size_t get_pending_transaction_count()const { return _pending_tx.size(); }
+      private:
+         block_processing_counters _block_processing_counters;
    };
 
 } }
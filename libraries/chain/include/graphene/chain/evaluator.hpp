@@ -23,6 +23,7 @@
  */
 #pragma once
 #include <graphene/chain/exceptions.hpp>
+#include <graphene/chain/execution_profiler.hpp>
 #include <graphene/chain/transaction_evaluation_state.hpp>
 #include <graphene/protocol/operations.hpp>
 
@@ -118,6 +119,8 @@ namespace graphene { namespace chain {
       const asset_object*              fee_asset          = nullptr;
       const asset_dynamic_data_object* fee_asset_dyn_data = nullptr;
       transaction_evaluation_state*    trx_state;
+      /// Set by start_evaluate() if the execution profiler is enabled
+      execution_profiler*              profiler = nullptr;
    };
 
    class op_evaluator
@@ -149,16 +152,20 @@ namespace graphene { namespace chain {
          auto* eval = static_cast<DerivedEvaluator*>(this);
          const auto& op = o.get<typename DerivedEvaluator::operation_type>();
 
-         prepare_fee(op.fee_payer(), op.fee);
-         if( !trx_state->skip_fee_schedule_check )
          {
-            share_type required_fee = calculate_fee_for_operation(op);
-            GRAPHENE_ASSERT( core_fee_paid >= required_fee,
-                       insufficient_fee,
-                       "Insufficient Fee Paid",
-                       ("core_fee_paid",core_fee_paid)("required", required_fee) );
+            execution_profiler::scoped_timer timer( profiler, get_type(), execution_profiler::phase::fee_check );
+            prepare_fee(op.fee_payer(), op.fee);
+            if( !trx_state->skip_fee_schedule_check )
+            {
+               share_type required_fee = calculate_fee_for_operation(op);
+               GRAPHENE_ASSERT( core_fee_paid >= required_fee,
+                          insufficient_fee,
+                          "Insufficient Fee Paid",
+                          ("core_fee_paid",core_fee_paid)("required", required_fee) );
+            }
          }
 
+         execution_profiler::scoped_timer timer( profiler, get_type(), execution_profiler::phase::evaluate );
          return eval->do_evaluate(op);
       }
 
@@ -167,10 +174,17 @@ namespace graphene { namespace chain {
          auto* eval = static_cast<DerivedEvaluator*>(this);
          const auto& op = o.get<typename DerivedEvaluator::operation_type>();
 
-         convert_fee();
-         pay_fee();
+         {
+            execution_profiler::scoped_timer timer( profiler, get_type(), execution_profiler::phase::fee_payment );
+            convert_fee();
+            pay_fee();
+         }
 
-         auto result = eval->do_apply(op);
+         operation_result result;
+         {
+            execution_profiler::scoped_timer timer( profiler, get_type(), execution_profiler::phase::apply );
+            result = eval->do_apply(op);
+         }
 
          db_adjust_balance(op.fee_payer(), -fee_from_account);
 
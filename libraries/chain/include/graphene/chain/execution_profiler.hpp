@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026 BitShares Blockchain Foundation, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/chain/types.hpp>
+#include <graphene/protocol/transaction.hpp>
+
+#include <fc/container/flat.hpp>
+#include <fc/filesystem.hpp>
+#include <fc/time.hpp>
+
+#include <deque>
+#include <memory>
+
+namespace graphene { namespace db {
+   class object_database;
+   class index_observer;
+} }
+
+namespace graphene { namespace chain {
+
+   /**
+    * @brief Statistics of execution times, in microseconds
+    *
+    * Bucket @c i counts the samples which took less than 2^i microseconds but not less than 2^(i-1) microseconds,
+    * the last bucket counts all the slower samples.
+    */
+   struct execution_time_histogram
+   {
+      static constexpr size_t bucket_count = 24;
+
+      uint64_t          count = 0;
+      uint64_t          total = 0;
+      uint64_t          max   = 0;
+      vector<uint64_t>  buckets;
+
+      void add( const fc::microseconds& elapsed );
+   };
+
+   /// Execution statistics of one type of operations
+   struct operation_execution_profile
+   {
+      int64_t                   operation_type = 0;
+      string                    operation_name;
+      execution_time_histogram  total;       ///< The whole operation, as applied by @ref database::apply_operation
+      execution_time_histogram  fee_check;   ///< Fee preparation and validation before @c do_evaluate()
+      execution_time_histogram  evaluate;    ///< @c do_evaluate()
+      execution_time_histogram  fee_payment; ///< Fee conversion and payment before @c do_apply()
+      execution_time_histogram  apply;       ///< @c do_apply()
+   };
+
+   /// Numbers of objects created, modified and removed in one index
+   struct index_change_counts
+   {
+      uint8_t   space_id = 0;
+      uint8_t   type_id  = 0;
+      uint64_t  created  = 0;
+      uint64_t  modified = 0;
+      uint64_t  removed  = 0;
+   };
+
+   struct block_execution_profile
+   {
+      uint32_t                     block_num    = 0;
+      int64_t                      apply_time   = 0; ///< In microseconds
+      uint32_t                     transactions = 0;
+      vector<index_change_counts>  object_changes;
+   };
+
+   struct transaction_execution_profile
+   {
+      transaction_id_type  trx_id;
+      uint32_t             block_num  = 0; ///< 0 if the transaction was not applied as a part of a block
+      uint32_t             operations = 0;
+      int64_t              apply_time = 0; ///< In microseconds
+   };
+
+   struct execution_profile
+   {
+      fc::time_point                         started;
+      vector<operation_execution_profile>    operations;           ///< Only the operation types seen so far
+      vector<block_execution_profile>        recent_blocks;        ///< Oldest first
+      vector<transaction_execution_profile>  slowest_transactions; ///< Slowest first
+   };
+
+   /**
+    * @brief Collects execution statistics of blocks, transactions, operations and object changes
+    *
+    * The profiler is disabled by default. When disabled, the only overhead is to check the flag.
+    */
+   class execution_profiler
+   {
+      public:
+         static constexpr size_t max_recent_blocks        = 100;
+         static constexpr size_t max_slowest_transactions = 20;
+
+         enum class phase
+         {
+            total,
+            fee_check,
+            evaluate,
+            fee_payment,
+            apply
+         };
+
+         /// Measures the time spent in its scope and records it in the profiler, if there is one
+         class scoped_timer
+         {
+            public:
+               scoped_timer( execution_profiler* profiler, int64_t operation_type, phase p )
+               : _profiler( profiler ), _operation_type( operation_type ), _phase( p )
+               {
+                  if( _profiler )
+                     _start = fc::time_point::now();
+               }
+               ~scoped_timer()
+               {
+                  if( _profiler )
+                     _profiler->record_operation( _operation_type, _phase, fc::time_point::now() - _start );
+               }
+            private:
+               execution_profiler* _profiler;
+               int64_t             _operation_type;
+               phase               _phase;
+               fc::time_point      _start;
+         };
+
+         execution_profiler();
+         ~execution_profiler();
+
+         bool is_enabled()const { return _enabled; }
+
+         /// Enable or disable the profiler, enabling it discards the data collected so far
+         void enable( bool enabled, graphene::db::object_database& db );
+
+         void record_operation( int64_t operation_type, phase p, const fc::microseconds& elapsed );
+         void record_transaction( const signed_transaction& trx, uint32_t block_num, const fc::microseconds& elapsed );
+
+         /// Object changes are only counted between @ref start_block and @ref finish_block
+         void start_block( uint32_t block_num );
+         void finish_block( uint32_t transactions, const fc::microseconds& elapsed );
+
+         execution_profile get_profile()const;
+         /// Save the profile to a file in JSON format
+         void dump_profile( const fc::path& filename )const;
+
+      private:
+         class object_change_counter;
+         friend class object_change_counter;
+
+         void record_object_change( const object_id_type& id, uint64_t index_change_counts::* counter );
+
+         bool                                          _enabled = false;
+         bool                                          _in_block = false;
+         fc::time_point                                _started;
+         /// Indexed by operation type
+         vector<operation_execution_profile>           _operations;
+         std::deque<block_execution_profile>           _recent_blocks;
+         /// Slowest first
+         vector<transaction_execution_profile>         _slowest_transactions;
+         block_execution_profile                       _current_block;
+         /// Object changes in the current block, the key is ( space_id << 8 ) | type_id
+         flat_map<uint16_t, index_change_counts>       _current_block_changes;
+         /// Observes all the indexes once the profiler has been enabled
+         std::shared_ptr<graphene::db::index_observer> _observer;
+   };
+
+} } // graphene::chain
+
+FC_REFLECT( graphene::chain::execution_time_histogram, (count)(total)(max)(buckets) )
+FC_REFLECT( graphene::chain::operation_execution_profile,
+            (operation_type)(operation_name)(total)(fee_check)(evaluate)(fee_payment)(apply) )
+FC_REFLECT( graphene::chain::index_change_counts, (space_id)(type_id)(created)(modified)(removed) )
+FC_REFLECT( graphene::chain::block_execution_profile, (block_num)(apply_time)(transactions)(object_changes) )
+FC_REFLECT( graphene::chain::transaction_execution_profile, (trx_id)(block_num)(operations)(apply_time) )
+FC_REFLECT( graphene::chain::execution_profile, (started)(operations)(recent_blocks)(slowest_transactions) )
@@ -128,6 +128,13 @@ struct genesis_state_type {
    /// Method to override initial witness signing keys for debug
    void override_witness_signing_keys( const std::string& new_key );
 
+   /**
+    * Same as var.as<genesis_state_type>( max_depth ), but converts the initial accounts, balances and vesting
+    * balances of a large genesis state in parallel chunks. Decoding their keys and addresses dominates the time
+    * it takes to load such a genesis state.
+    */
+   static genesis_state_type from_variant_parallel( const fc::variant& var, uint32_t max_depth );
+
 };
 
 } } // namespace graphene::chain
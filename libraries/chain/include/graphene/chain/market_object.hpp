@@ -29,6 +29,9 @@
 
 #include <boost/multi_index/composite_key.hpp>
 
+#include <map>
+#include <set>
+
 namespace graphene { namespace chain {
 
 using namespace graphene::db;
@@ -287,6 +290,32 @@ typedef generic_index<call_order_object, call_order_multi_index_type>
 typedef generic_index<force_settlement_object, force_settlement_object_multi_index_type>   force_settlement_index;
 typedef generic_index<collateral_bid_object, collateral_bid_object_multi_index_type>       collateral_bid_index;
 
+/**
+ *  @brief This secondary index tracks the settlement dates of the force settlement orders of each asset,
+ *         so that only the assets which have orders need to be visited when processing force settlements.
+ */
+class force_settlement_schedule_index : public secondary_index
+{
+   public:
+      using dates_by_asset_type = std::map< asset_id_type, std::multiset<time_point_sec> >;
+
+      virtual void object_inserted( const object& obj ) override;
+      virtual void object_removed( const object& obj ) override;
+      virtual void about_to_modify( const object& before ) override;
+      virtual void object_modified( const object& after  ) override;
+
+      /// @return the settlement dates of the orders of each asset which has force settlement orders,
+      ///         ordered by asset ID
+      const dates_by_asset_type& get_dates_by_asset()const { return _dates_by_asset; }
+
+   private:
+      void remove_settlement_date( asset_id_type asset, time_point_sec date );
+
+      dates_by_asset_type _dates_by_asset;
+      /// Settlement date of the order being modified
+      time_point_sec      _date_before_modify;
+};
+
 } } // graphene::chain
 
 MAP_OBJECT_ID_TO_TYPE(graphene::chain::limit_order_object)
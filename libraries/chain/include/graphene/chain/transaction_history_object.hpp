@@ -40,6 +40,9 @@ namespace graphene { namespace chain {
     * The purpose of this object is to enable the detection of duplicate transactions. When a transaction is included
     * in a block a transaction_history_object is added. At the end of block processing all transaction_history_objects that
     * have expired can be removed from the index.
+    *
+    * The transaction itself is not stored here, only where to find it: in the block that contains it, or among the
+    * pending transactions if it is not in a block yet, see database::get_recent_transaction().
     */
    class transaction_history_object : public abstract_object<transaction_history_object>
    {
@@ -47,10 +50,12 @@ namespace graphene { namespace chain {
          static constexpr uint8_t space_id = implementation_ids;
          static constexpr uint8_t type_id  = impl_transaction_history_object_type;
 
-         signed_transaction  trx;
          transaction_id_type trx_id;
+         time_point_sec      expiration;
+         uint32_t            block_num = 0;    ///< the block containing the transaction, 0 if it is pending
+         uint16_t            trx_in_block = 0; ///< position of the transaction in the block
 
-         time_point_sec get_expiration()const { return trx.expiration; }
+         time_point_sec get_expiration()const { return expiration; }
    };
 
    struct by_expiration;
@@ -306,6 +306,46 @@ share_type call_order_object::get_max_debt_to_cover( price match_price,
 
 } FC_CAPTURE_AND_RETHROW( (*this)(feed_price)(match_price)(maintenance_collateral_ratio) ) }
 
+void force_settlement_schedule_index::object_inserted( const object& obj )
+{
+   const auto& settle = dynamic_cast< const force_settlement_object& >( obj );
+   _dates_by_asset[settle.settlement_asset_id()].insert( settle.settlement_date );
+}
+
+void force_settlement_schedule_index::object_removed( const object& obj )
+{
+   const auto& settle = dynamic_cast< const force_settlement_object& >( obj );
+   remove_settlement_date( settle.settlement_asset_id(), settle.settlement_date );
+}
+
+void force_settlement_schedule_index::about_to_modify( const object& before )
+{
+   const auto& settle = dynamic_cast< const force_settlement_object& >( before );
+   _date_before_modify = settle.settlement_date;
+}
+
+void force_settlement_schedule_index::object_modified( const object& after  )
+{
+   const auto& settle = dynamic_cast< const force_settlement_object& >( after );
+   if( settle.settlement_date == _date_before_modify )
+      return;
+   remove_settlement_date( settle.settlement_asset_id(), _date_before_modify );
+   _dates_by_asset[settle.settlement_asset_id()].insert( settle.settlement_date );
+}
+
+void force_settlement_schedule_index::remove_settlement_date( asset_id_type asset, time_point_sec date )
+{
+   auto asset_itr = _dates_by_asset.find( asset );
+   if( asset_itr == _dates_by_asset.end() )
+      return;
+   auto& dates = asset_itr->second;
+   auto date_itr = dates.find( date );
+   if( date_itr != dates.end() )
+      dates.erase( date_itr );
+   if( dates.empty() )
+      _dates_by_asset.erase( asset_itr );
+}
+
 FC_REFLECT_DERIVED_NO_TYPENAME( graphene::chain::limit_order_object,
                     (graphene::db::object),
                     (expiration)(seller)(for_sale)(sell_price)(deferred_fee)(deferred_paid_fee)
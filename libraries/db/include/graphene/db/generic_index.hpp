@@ -110,6 +110,9 @@ namespace graphene { namespace db {
             } FC_CAPTURE_AND_RETHROW()
          }
 
+         virtual size_t object_count()const override { return _indices.size(); }
+         virtual size_t object_size()const override { return sizeof(ObjectType); }
+
          const index_type& indices()const { return _indices; }
 
       private:
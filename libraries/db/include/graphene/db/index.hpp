@@ -31,6 +31,7 @@
 
 #include <fstream>
 #include <stack>
+#include <unordered_map>
 
 namespace graphene { namespace db {
    class object_database;
@@ -130,6 +131,10 @@ namespace graphene { namespace db {
          }
 
          virtual void               inspect_all_objects(std::function<void(const object&)> inspector)const = 0;
+         /** @return the number of objects in the index */
+         virtual size_t             object_count()const = 0;
+         /** @return the size of the indexed object type, not including memory allocated by the objects */
+         virtual size_t             object_size()const = 0;
          virtual void               add_observer( const shared_ptr<index_observer>& ) = 0;
 
          virtual void               object_from_variant( const fc::variant& var, object& obj, uint32_t max_depth )const = 0;
@@ -170,12 +175,26 @@ namespace graphene { namespace db {
          T* add_secondary_index(Args... args)
          {
             _sindex.emplace_back( std::make_unique<T>(args...) );
-            return static_cast<T*>(_sindex.back().get());
+            T* result = static_cast<T*>(_sindex.back().get());
+            const size_t slot = secondary_index_slot<T>();
+            if( _sindex_by_slot.size() <= slot )
+               _sindex_by_slot.resize( slot + 1, nullptr );
+            if( _sindex_by_slot[slot] == nullptr )
+               _sindex_by_slot[slot] = result;
+            return result;
          }
 
+         /**
+          * Secondary indexes are registered under a slot that is unique to their type, so looking up
+          * an index by its exact type is a plain array access.  Looking up an index by one of its base
+          * classes falls back to scanning all secondary indexes.
+          */
          template<typename T>
          const T& get_secondary_index()const
          {
+            const size_t slot = secondary_index_slot<T>();
+            if( slot < _sindex_by_slot.size() && _sindex_by_slot[slot] != nullptr )
+               return *static_cast<const T*>( _sindex_by_slot[slot] );
             for( const auto& item : _sindex )
             {
                const T* result = dynamic_cast<const T*>(item.get());
@@ -189,7 +208,18 @@ namespace graphene { namespace db {
          vector< unique_ptr<secondary_index> >  _sindex;
 
       private:
+         static size_t allocate_secondary_index_slot();
+
+         template<typename T>
+         static size_t secondary_index_slot()
+         {
+            static const size_t slot = allocate_secondary_index_slot();
+            return slot;
+         }
+
          object_database& _db;
+         /// the first secondary index of each type, indexed by secondary_index_slot<T>()
+         vector< const secondary_index* >       _sindex_by_slot;
    };
 
    /** @class direct_index
@@ -298,6 +328,64 @@ namespace graphene { namespace db {
          };
    };
 
+   /** @class hash_index
+    *  @brief A secondary index that tracks objects in a hash map keyed by
+    *  object instance. Unlike direct_index it tolerates holes of any size, and
+    *  its memory use follows the number of live objects rather than the
+    *  highest id. It is meant for indexes whose ids grow monotonically while
+    *  most old objects are deleted, e.g. orders.
+    *
+    *  WARNING! If any of the methods called on insertion, removal or
+    *  modification throws, subsequent behaviour is undefined!
+    */
+   template<typename Object>
+   class hash_index : public secondary_index
+   {
+      // private
+         std::unordered_map< uint64_t, const Object* > content;
+         std::stack< object_id_type > ids_being_modified;
+
+      public:
+         virtual ~hash_index(){}
+
+         virtual void object_inserted( const object& obj )
+         {
+            FC_ASSERT( nullptr != dynamic_cast<const Object*>(&obj), "Wrong object type!" );
+            bool inserted = content.emplace( obj.id.instance(), static_cast<const Object*>( &obj ) ).second;
+            FC_ASSERT( inserted, "Overwriting insert at {id}!", ("id",obj.id) );
+         }
+
+         virtual void object_removed( const object& obj )
+         {
+            FC_ASSERT( nullptr != dynamic_cast<const Object*>(&obj), "Wrong object type!" );
+            size_t removed = content.erase( obj.id.instance() );
+            FC_ASSERT( removed == 1, "Removing non-existent object {id}!", ("id",obj.id) );
+         }
+
+         virtual void about_to_modify( const object& before )
+         {
+            ids_being_modified.emplace( before.id );
+         }
+
+         virtual void object_modified( const object& after  )
+         {
+            FC_ASSERT( ids_being_modified.top() == after.id, "Modification of ID is not supported!");
+            ids_being_modified.pop();
+         }
+
+         const Object* find( const object_id_type& id )const
+         {
+            FC_ASSERT( id.space() == Object::space_id, "Space ID mismatch!" );
+            FC_ASSERT( id.type() == Object::type_id, "Type_ID mismatch!" );
+            auto itr = content.find( id.instance() );
+            if( itr == content.end() ) return nullptr;
+            return itr->second;
+         }
+
+         /** @return the number of objects tracked */
+         size_t size()const { return content.size(); }
+   };
+
    /**
     * @class primary_index
     * @brief  Wraps a derived index to intercept calls to create, modify, and remove so that
@@ -333,9 +421,24 @@ namespace graphene { namespace db {
          {
             if( DirectBits > 0 )
                return _direct_by_id->find( id );
+            if( _hash_by_id != nullptr )
+               return _hash_by_id->find( id );
             return DerivedIndex::find( id );
          }
 
+         /**
+          * Resolve find() through a hash_index instead of the id lookup of the derived index.
+          * Cannot be combined with DirectBits.
+          */
+         void use_hash_index()
+         {
+            FC_ASSERT( DirectBits == 0, "Index already uses a direct_index" );
+            FC_ASSERT( _hash_by_id == nullptr, "Index already uses a hash_index" );
+            auto hashed = add_secondary_index< hash_index< object_type > >();
+            this->inspect_all_objects( [hashed]( const object& o ) { hashed->object_inserted( o ); } );
+            _hash_by_id = hashed;
+         }
+
          fc::sha256 get_object_version()const
          {
             std::string desc = "1.0";//get_type_description<object_type>();
@@ -448,6 +551,7 @@ namespace graphene { namespace db {
       private:
          object_id_type                                 _next_id;
          const direct_index< object_type, DirectBits >* _direct_by_id = nullptr;
+         const hash_index< object_type >*               _hash_by_id = nullptr;
    };
 
 } } // graphene::db
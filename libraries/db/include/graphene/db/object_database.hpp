@@ -53,6 +53,11 @@ namespace graphene { namespace db {
          void wipe(const fc::path& data_dir); // remove from disk
          void close();
 
+         /// Adds the observer to all the indexes which have been added so far
+         void add_index_observer( const shared_ptr<index_observer>& observer );
+         /// Calls the inspector with every index which has been added
+         void inspect_all_indexes( const std::function<void(const index&)>& inspector )const;
+
          template<typename T, typename F>
          const T& create( F&& constructor )
          {
@@ -24,6 +24,8 @@
 #pragma once
 #include <graphene/db/index.hpp>
 
+#include <algorithm>
+
 namespace graphene { namespace db {
 
    /**
@@ -99,6 +101,13 @@ namespace graphene { namespace db {
             } FC_CAPTURE_AND_RETHROW()
          }
 
+         virtual size_t object_count()const override
+         {
+            return std::count_if( _objects.begin(), _objects.end(),
+                                  []( const unique_ptr<object>& ptr ) { return ptr != nullptr; } );
+         }
+         virtual size_t object_size()const override { return sizeof(T); }
+
          class const_iterator
          {
             public:
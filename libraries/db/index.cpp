@@ -25,7 +25,15 @@
 #include <graphene/db/index.hpp>
 #include <graphene/db/object_database.hpp>
 
+#include <atomic>
+
 namespace graphene { namespace db {
+   size_t base_primary_index::allocate_secondary_index_slot()
+   {
+      static std::atomic<size_t> next_slot( 0 );
+      return next_slot++;
+   }
+
    void base_primary_index::save_undo( const object& obj )
    { _db.save_undo( obj ); }
 
@@ -80,6 +80,22 @@ index& object_database::get_mutable_index(uint8_t space_id, uint8_t type_id)
    return *idx;
 }
 
+void object_database::add_index_observer( const shared_ptr<index_observer>& observer )
+{
+   for( auto& space : _index )
+      for( auto& idx : space )
+         if( idx )
+            idx->add_observer( observer );
+}
+
+void object_database::inspect_all_indexes( const std::function<void(const index&)>& inspector )const
+{
+   for( const auto& space : _index )
+      for( const auto& idx : space )
+         if( idx )
+            inspector( *idx );
+}
+
 void object_database::flush()
 {
    const auto tmp_dir = _data_dir / "object_database.tmp";
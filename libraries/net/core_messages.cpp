@@ -47,6 +47,33 @@ namespace graphene { namespace net {
   const core_message_type_enum get_current_connections_request_message::type = core_message_type_enum::get_current_connections_request_message_type;
   const core_message_type_enum get_current_connections_reply_message::type   = core_message_type_enum::get_current_connections_reply_message_type;
 
+  message block_message::from_packed_block( std::vector<char> packed_block, const block_id_type& id )
+  {
+     // the packed block_message is the packed block followed by the packed block_id
+     const std::vector<char> packed_id = fc::raw::pack( id );
+     message result;
+     result.msg_type = block_message::type;
+     result.data = std::move( packed_block );
+     result.data.insert( result.data.end(), packed_id.begin(), packed_id.end() );
+     result.size = (uint32_t)result.data.size();
+     return result;
+  }
+
+  message block_message::from_block( const signed_block& blk )
+  {
+     return from_packed_block( blk.get_packed(), blk.id() );
+  }
+
+  message trx_message::from_transaction( const graphene::protocol::precomputable_transaction& trx )
+  {
+     // the packed trx_message is the packed transaction, which is reflected the same as a signed_transaction
+     message result;
+     result.msg_type = trx_message::type;
+     result.data = *trx.get_packed_signed_transaction();
+     result.size = (uint32_t)result.data.size();
+     return result;
+  }
+
 } } // graphene::net
 
 FC_REFLECT_DERIVED_NO_TYPENAME( graphene::net::trx_message, BOOST_PP_SEQ_NIL, (trx) )
@@ -39,6 +39,13 @@
  * 2MiB
  */
 #define MAX_MESSAGE_SIZE                                     1024*1024*2
+/**
+ * Message bodies at least this large are encrypted and decrypted in the
+ * thread pool instead of on the p2p thread, so that one large block does
+ * not stall every other connection while its AES runs.
+ */
+#define GRAPHENE_NET_PARALLEL_CRYPTO_THRESHOLD               (64*1024)
+
 #define GRAPHENE_NET_DEFAULT_PEER_CONNECTION_RETRY_TIME      30 // seconds
 
 /**
@@ -73,6 +80,13 @@
  */
 #define GRAPHENE_NET_MESSAGE_CACHE_DURATION_IN_BLOCKS        5
 
+/**
+ * Upper bound on the memory held by the message cache.  When a flood of
+ * transactions fills it before the messages age out, the oldest messages
+ * are evicted first.
+ */
+#define GRAPHENE_NET_MESSAGE_CACHE_MAX_SIZE_IN_BYTES         (64 * 1024 * 1024)
+
 /**
  * We prevent a peer from offering us a list of blocks which, if we fetched them
  * all, would result in a blockchain that extended into the future.
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <graphene/net/config.hpp>
+#include <graphene/net/message.hpp>
 
 #include <fc/crypto/ripemd160.hpp>
 #include <fc/crypto/elliptic.hpp>
@@ -40,6 +41,7 @@
 
 namespace graphene { namespace net {
   using graphene::protocol::signed_transaction;
+  using graphene::protocol::precomputable_transaction;
   using graphene::protocol::block_id_type;
   using graphene::protocol::transaction_id_type;
   using graphene::protocol::signed_block;
@@ -99,6 +101,12 @@ namespace graphene { namespace net {
       explicit trx_message(const graphene::protocol::signed_transaction& signed_trx) :
         trx(signed_trx)
       {}
+
+      /**
+       * Builds a message with the wire format of a trx_message from the packed transaction cached in the
+       * given transaction, without packing it again
+       */
+      static message from_transaction( const graphene::protocol::precomputable_transaction& trx );
    };
 
    struct block_message
@@ -112,6 +120,17 @@ namespace graphene { namespace net {
       signed_block    block;
       block_id_type   block_id;
 
+      /**
+       * Builds a message with the wire format of a block_message from a block which is already
+       * packed with fc::raw, e.g. as stored in the block database, without unpacking and packing it again
+       */
+      static message from_packed_block( std::vector<char> packed_block, const block_id_type& id );
+
+      /**
+       * Builds a message with the wire format of a block_message from a block, reusing the packed transactions
+       * cached in the block
+       */
+      static message from_block( const signed_block& blk );
    };
 
   struct item_ids_inventory_message
@@ -32,6 +32,8 @@
 #include <fc/crypto/ripemd160.hpp>
 #include <fc/reflect/typename.hpp>
 
+#include <memory>
+
 namespace graphene { namespace net {
 
   /**
@@ -116,6 +118,13 @@ namespace graphene { namespace net {
      }
   };
 
+  /**
+   *  An immutable message that can be shared between the message cache and the send
+   *  queues of many peers, so that relaying a message does not copy its payload once
+   *  per peer.
+   */
+  using message_ptr = std::shared_ptr<const message>;
+
 } } // graphene::net
 
 FC_REFLECT_TYPENAME( graphene::net::message_header )
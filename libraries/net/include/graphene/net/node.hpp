@@ -281,6 +281,10 @@ namespace graphene { namespace net {
         {
            broadcast( trx_message(trx) );
         }
+        virtual void  broadcast_transaction( const precomputable_transaction& trx )
+        {
+           broadcast( trx_message::from_transaction(trx) );
+        }
 
         /**
          *  Node starts the process of fetching all items after item_id of the
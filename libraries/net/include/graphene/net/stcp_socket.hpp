@@ -26,6 +26,8 @@
 #include <fc/crypto/aes.hpp>
 #include <fc/crypto/elliptic.hpp>
 
+#include <vector>
+
 namespace graphene { namespace net {
 
 /**
@@ -53,6 +55,18 @@ class stcp_socket : public virtual fc::iostream
     virtual void     flush();
     virtual void     close();
 
+    /**
+     *  Reads and decrypts the bytes of @p data after @p offset, their number must be a multiple of 16.
+     *  Large reads are decrypted in place in the thread pool, so the calling thread can
+     *  serve other connections in the meantime.  @p data may be left empty if this throws.
+     */
+    void             read_padded( std::vector<char>& data, size_t offset );
+    /**
+     *  Encrypts and writes all of @p data, whose size must be a multiple of 16.
+     *  Large writes are encrypted in place in the thread pool.
+     */
+    void             write_padded( std::vector<char>&& data );
+
     using istream::get;
     void             get( char& c ) { read( &c, 1 ); }
     fc::sha512       get_shared_secret() const { return _shared_secret; }
@@ -62,8 +76,10 @@ class stcp_socket : public virtual fc::iostream
     fc::sha512           _shared_secret;
     fc::ecc::private_key _priv_key;
     fc::tcp_socket       _sock;
-    fc::aes_encoder      _send_aes;
-    fc::aes_decoder      _recv_aes;
+    // shared with the thread pool while a large message is being encrypted or decrypted,
+    // which may outlive this socket if the calling task is canceled
+    std::shared_ptr<fc::aes_encoder> _send_aes;
+    std::shared_ptr<fc::aes_decoder> _recv_aes;
     std::shared_ptr<char> _read_buffer;
     std::shared_ptr<char> _write_buffer;
 #ifndef NDEBUG
@@ -189,7 +189,7 @@ namespace graphene { namespace net {
           std::copy(buffer + sizeof(message_header), buffer + sizeof(buffer), m.data.begin());
           if (remaining_bytes_with_padding)
           {
-            _sock.read(&m.data[LEFTOVER], remaining_bytes_with_padding);
+            _sock.read_padded(m.data, LEFTOVER);
             _bytes_received += remaining_bytes_with_padding;
           }
           m.data.resize(m.size.value()); // truncate off the padding bytes
@@ -280,7 +280,7 @@ namespace graphene { namespace net {
                 message_to_send.size.value() );
         char* padding_space = padded_message.data() + sizeof(message_header) + message_to_send.size.value();
         memset(padding_space, 0, size_with_padding - size_of_message_and_header);
-        _sock.write( padded_message.data(), size_with_padding );
+        _sock.write_padded( std::move(padded_message) );
         _sock.flush();
         _bytes_sent += size_with_padding;
         _last_message_sent_time = fc::time_point::now();
@@ -93,43 +93,109 @@
 
 namespace graphene { namespace net { namespace detail {
 
+   void blockchain_tied_message_cache::evict_oldest()
+   {
+      auto& by_age = _message_cache.get<insertion_order_index>();
+      _size_in_bytes -= by_age.front().size_in_bytes();
+      by_age.pop_front();
+   }
+
+   void blockchain_tied_message_cache::enforce_size_limit()
+   {
+      // never evict the newest message, we have just advertised it to our peers
+      while( _size_in_bytes > _max_size_in_bytes && _message_cache.size() > 1 )
+      {
+         evict_oldest();
+         ++_evicted_by_size;
+      }
+   }
+
    void blockchain_tied_message_cache::block_accepted()
    {
       ++block_clock;
       if( block_clock > cache_duration_in_blocks )
-         _message_cache.get<block_clock_index>().erase(_message_cache.get<block_clock_index>().begin(),
-               _message_cache.get<block_clock_index>().lower_bound(block_clock - cache_duration_in_blocks ) );
+      {
+         const auto& by_age = _message_cache.get<insertion_order_index>();
+         while( !by_age.empty()
+               && by_age.front().block_clock_when_received < block_clock - cache_duration_in_blocks )
+         {
+            evict_oldest();
+            ++_evicted_by_age;
+         }
+      }
    }
 
-   void blockchain_tied_message_cache::cache_message( const message& message_to_cache,
+   void blockchain_tied_message_cache::cache_message( message_ptr message_to_cache,
                                                       const message_hash_type& hash_of_message_to_cache,
                                                       const message_propagation_data& propagation_data,
                                                       const message_hash_type& message_content_hash )
    {
-      _message_cache.insert( message_info(hash_of_message_to_cache,
-                                         message_to_cache,
-                                         block_clock,
-                                         propagation_data,
-                                         message_content_hash ) );
+      auto result = _message_cache.insert( message_info(hash_of_message_to_cache,
+                                                        std::move(message_to_cache),
+                                                        block_clock,
+                                                        propagation_data,
+                                                        message_content_hash ) );
+      if( result.second )
+      {
+         _size_in_bytes += result.first->size_in_bytes();
+         enforce_size_limit();
+      }
    }
 
-   message blockchain_tied_message_cache::get_message( const message_hash_type& hash_of_message_to_lookup ) const
+   message_ptr blockchain_tied_message_cache::get_message( const message_hash_type& hash_of_message_to_lookup ) const
    {
-      message_cache_container::index<message_hash_index>::type::const_iterator iter =
-         _message_cache.get<message_hash_index>().find(hash_of_message_to_lookup );
-      if( iter != _message_cache.get<message_hash_index>().end() )
+      const auto& by_hash = _message_cache.get<message_hash_index>();
+      auto iter = by_hash.find( hash_of_message_to_lookup );
+      if( iter != by_hash.end() )
+      {
+         ++_hits;
          return iter->message_body;
+      }
+      ++_misses;
       FC_THROW_EXCEPTION(  fc::key_not_found_exception, "Requested message not in cache" );
    }
 
+   message_ptr blockchain_tied_message_cache::get_message_by_contents_hash(
+         const message_hash_type& hash_of_msg_contents_to_lookup ) const
+   {
+      const auto& by_contents_hash = _message_cache.get<message_contents_hash_index>();
+      auto iter = by_contents_hash.find( hash_of_msg_contents_to_lookup );
+      if( iter != by_contents_hash.end() )
+      {
+         ++_hits;
+         return iter->message_body;
+      }
+      ++_misses;
+      FC_THROW_EXCEPTION(  fc::key_not_found_exception, "Requested message not in cache" );
+   }
+
+   void blockchain_tied_message_cache::set_max_size_in_bytes( size_t max_size_in_bytes )
+   {
+      _max_size_in_bytes = max_size_in_bytes;
+      enforce_size_limit();
+   }
+
+   fc::variant_object blockchain_tied_message_cache::get_info() const
+   {
+      fc::mutable_variant_object info;
+      info["messages"] = _message_cache.size();
+      info["size_in_bytes"] = _size_in_bytes;
+      info["max_size_in_bytes"] = _max_size_in_bytes;
+      info["hits"] = _hits;
+      info["misses"] = _misses;
+      info["evicted_by_age"] = _evicted_by_age;
+      info["evicted_by_size"] = _evicted_by_size;
+      return info;
+   }
+
     message_propagation_data blockchain_tied_message_cache::get_message_propagation_data(
              const message_hash_type& hash_of_msg_contents_to_lookup ) const
     {
       if( hash_of_msg_contents_to_lookup != message_hash_type() )
       {
-        message_cache_container::index<message_contents_hash_index>::type::const_iterator iter =
-           _message_cache.get<message_contents_hash_index>().find(hash_of_msg_contents_to_lookup );
-        if( iter != _message_cache.get<message_contents_hash_index>().end() )
+        const auto& by_contents_hash = _message_cache.get<message_contents_hash_index>();
+        auto iter = by_contents_hash.find( hash_of_msg_contents_to_lookup );
+        if( iter != by_contents_hash.end() )
           return iter->propagation_data;
       }
       FC_THROW_EXCEPTION(  fc::key_not_found_exception, "Requested message not in cache" );
@@ -2255,21 +2321,24 @@ namespace graphene { namespace net { namespace detail {
       }
     }
 
-    message node_impl::get_message_for_item(const item_id& item)
+    message_ptr node_impl::get_message_for_item(const item_id& item)
     {
       try
       {
+        // blocks are queued by their block IDs, so that all peers fetching a block share the cached message
+        if (item.item_type == block_message_type)
+          return _message_cache.get_message_by_contents_hash(item.item_hash);
         return _message_cache.get_message(item.item_hash);
       }
       catch (fc::key_not_found_exception&)
       {}
       try
       {
-        return _delegate->get_item(item);
+        return std::make_shared<const message>(_delegate->get_item(item));
       }
       catch (fc::key_not_found_exception&)
       {}
-      return item_not_available_message(item);
+      return std::make_shared<const message>(item_not_available_message(item));
     }
 
     void node_impl::on_fetch_items_message(peer_connection* originating_peer,
@@ -2281,20 +2350,26 @@ namespace graphene { namespace net { namespace detail {
            ("type", fetch_items_message_received.item_type)
            ("endpoint", originating_peer->get_remote_endpoint()));
 
-      fc::optional<message> last_block_message_sent;
+      fc::optional<item_hash_t> last_block_id_sent;
 
-      std::list<message> reply_messages;
+      // Messages found in the cache are queued as they are, so that they are shared with the cache and
+      // with other peers.  Blocks which have to come from the delegate are queued by their block IDs and
+      // only fetched again when they reach the front of the queue, they are null here.
+      std::list<std::pair<item_hash_t, message_ptr>> reply_messages;
       for (const item_hash_t& item_hash : fetch_items_message_received.items_to_fetch)
       {
         try
         {
-          message requested_message = _message_cache.get_message(item_hash);
+          message_ptr requested_message = _message_cache.get_message(item_hash);
           dlog("received item request for item ${id} from peer ${endpoint}, returning the item from my message cache",
                ("endpoint", originating_peer->get_remote_endpoint())
-               ("id", requested_message.id()));
-          reply_messages.push_back(requested_message);
+               ("id", item_hash));
           if (fetch_items_message_received.item_type == block_message_type)
-            last_block_message_sent = requested_message;
+          {
+            // the message cache is keyed by message hashes, which are not the block IDs
+            last_block_id_sent = requested_message->as<graphene::net::block_message>().block_id;
+          }
+          reply_messages.emplace_back(item_hash, std::move(requested_message));
           continue;
         }
         catch (fc::key_not_found_exception&)
@@ -2305,38 +2380,40 @@ namespace graphene { namespace net { namespace detail {
         item_id item_to_fetch(fetch_items_message_received.item_type, item_hash);
         try
         {
-          message requested_message = _delegate->get_item(item_to_fetch);
+          message_ptr requested_message = std::make_shared<const message>(_delegate->get_item(item_to_fetch));
           dlog("received item request from peer ${endpoint}, returning the item from delegate with id ${id} size ${size}",
-               ("id", requested_message.id())
-               ("size", requested_message.size)
+               ("id", requested_message->id())
+               ("size", requested_message->size)
                ("endpoint", originating_peer->get_remote_endpoint()));
-          reply_messages.push_back(requested_message);
           if (fetch_items_message_received.item_type == block_message_type)
-            last_block_message_sent = requested_message;
+          {
+            last_block_id_sent = item_hash; // the delegate looks up blocks by their IDs
+            requested_message.reset();
+          }
+          reply_messages.emplace_back(item_hash, std::move(requested_message));
           continue;
         }
         catch (fc::key_not_found_exception&)
         {
-          reply_messages.push_back(item_not_available_message(item_to_fetch));
+          reply_messages.emplace_back(item_hash, std::make_shared<const message>(item_not_available_message(item_to_fetch)));
           dlog("received item request from peer ${endpoint} but we don't have it",
                ("endpoint", originating_peer->get_remote_endpoint()));
         }
       }
 
       // if we sent them a block, update our record of the last block they've seen accordingly
-      if (last_block_message_sent)
+      if (last_block_id_sent)
       {
-        graphene::net::block_message block = last_block_message_sent->as<graphene::net::block_message>();
-        originating_peer->last_block_delegate_has_seen = block.block_id;
-        originating_peer->last_block_time_delegate_has_seen = _delegate->get_block_time(block.block_id);
+        originating_peer->last_block_delegate_has_seen = *last_block_id_sent;
+        originating_peer->last_block_time_delegate_has_seen = _delegate->get_block_time(*last_block_id_sent);
       }
 
-      for (const message& reply : reply_messages)
+      for (const auto& reply : reply_messages)
       {
-        if (reply.msg_type.value() == block_message_type)
-          originating_peer->send_item(item_id(block_message_type, reply.as<graphene::net::block_message>().block_id));
+        if (reply.second)
+          originating_peer->send_message(reply.second);
         else
-          originating_peer->send_message(reply);
+          originating_peer->send_item(item_id(block_message_type, reply.first));
       }
     }
 
@@ -3009,7 +3086,7 @@ namespace graphene { namespace net { namespace detail {
         }
         message_propagation_data propagation_data { message_receive_time, message_validated_time,
                                                     originating_peer->node_id };
-        broadcast( block_message_to_process, propagation_data );
+        broadcast( block_message::from_block( block_message_to_process.block ), propagation_data );
         _message_cache.block_accepted();
 
         if (is_hard_fork_block(block_number))
@@ -4384,7 +4461,8 @@ namespace graphene { namespace net { namespace detail {
       ilog( "node._new_received_sync_items size: ${size}", ("size", _new_received_sync_items.size() ) );
       ilog( "node._items_to_fetch size: ${size}", ("size", _items_to_fetch.size() ) );
       ilog( "node._new_inventory size: ${size}", ("size", _new_inventory.size() ) );
-      ilog( "node._message_cache size: ${size}", ("size", _message_cache.size() ) );
+      ilog( "node._message_cache size: ${size} (${bytes} bytes)",
+            ("size", _message_cache.size() )("bytes", _message_cache.size_in_bytes() ) );
       fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
       for( const peer_connection_ptr& peer : _active_connections )
       {
@@ -4499,6 +4577,8 @@ namespace graphene { namespace net { namespace detail {
         peer_details["lastrecv"] = peer->get_last_message_received_time().sec_since_epoch();
         peer_details["bytessent"] = peer->get_total_bytes_sent();
         peer_details["bytesrecv"] = peer->get_total_bytes_received();
+        peer_details["queued_messages"] = peer->get_queued_message_count();
+        peer_details["queued_bytes"] = peer->get_total_queued_messages_size();
         peer_details["conntime"] = peer->get_connection_time();
         peer_details["pingtime"] = "";
         peer_details["pingwait"] = "";
@@ -4576,7 +4656,9 @@ namespace graphene { namespace net { namespace detail {
       }
       message_hash_type hash_of_item_to_broadcast = item_to_broadcast.id();
 
-      _message_cache.cache_message( item_to_broadcast, hash_of_item_to_broadcast, propagation_data, hash_of_message_contents );
+      // the cached copy is shared with the send queues of all peers that fetch it
+      _message_cache.cache_message( std::make_shared<const message>( item_to_broadcast ), hash_of_item_to_broadcast,
+                                    propagation_data, hash_of_message_contents );
       _new_inventory.insert( item_id(item_to_broadcast.msg_type.value(), hash_of_item_to_broadcast ) );
       trigger_advertise_inventory_loop();
     }
@@ -4629,6 +4711,8 @@ namespace graphene { namespace net { namespace detail {
         _max_sync_blocks_to_prefetch = params["max_sync_blocks_to_prefetch"].as<uint32_t>(1);
       if (params.contains("max_sync_blocks_per_peer"))
         _max_sync_blocks_per_peer = params["max_sync_blocks_per_peer"].as<uint32_t>(1);
+      if (params.contains("max_message_cache_size_in_bytes"))
+        _message_cache.set_max_size_in_bytes(params["max_message_cache_size_in_bytes"].as<uint64_t>(1));
 
       _desired_number_of_connections = std::min(_desired_number_of_connections, _maximum_number_of_connections);
 
@@ -4648,6 +4732,7 @@ namespace graphene { namespace net { namespace detail {
       result["max_blocks_to_handle_at_once"] = _max_blocks_to_handle_at_once;
       result["max_sync_blocks_to_prefetch"] = _max_sync_blocks_to_prefetch;
       result["max_sync_blocks_per_peer"] = _max_sync_blocks_per_peer;
+      result["max_message_cache_size_in_bytes"] = _message_cache.get_max_size_in_bytes();
       return result;
     }
 
@@ -4719,6 +4804,7 @@ namespace graphene { namespace net { namespace detail {
       info["node_public_key"] = fc::variant( _node_public_key, 1 );
       info["node_id"] = fc::variant( _node_id, 1 );
       info["firewalled"] = fc::variant( _is_firewalled, 1 );
+      info["message_cache"] = _message_cache.get_info();
       return info;
     }
     fc::variant_object node_impl::network_get_usage_stats() const
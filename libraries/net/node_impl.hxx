@@ -18,9 +18,22 @@
 
 #include <memory>
 #include <mutex>
+#include <boost/circular_buffer.hpp>
+#include <boost/container/flat_set.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/accumulators/accumulators.hpp>
+#include <boost/accumulators/statistics/stats.hpp>
+#include <boost/accumulators/statistics/rolling_mean.hpp>
+#include <boost/accumulators/statistics/min.hpp>
+#include <boost/accumulators/statistics/max.hpp>
+#include <boost/accumulators/statistics/sum.hpp>
+#include <boost/accumulators/statistics/count.hpp>
 #include <fc/thread/thread.hpp>
+#include <fc/thread/mutex.hpp>
+#include <fc/thread/scoped_lock.hpp>
 #include <fc/log/logger.hpp>
 #include <fc/network/tcp_socket.hpp>
+#include <fc/network/rate_limiting.hpp>
 #include <graphene/chain/config.hpp>
 #include <graphene/protocol/types.hpp>
 #include <graphene/net/node.hpp>
@@ -148,6 +161,12 @@ public:
    }
 };   
 
+/**
+ * Keeps the messages we have broadcast or relayed so that peers can fetch them.
+ *
+ * Messages expire after a number of blocks, and the oldest ones are evicted early
+ * whenever the cache holds more than its byte budget.  Lookups are hashed.
+ */
 class blockchain_tied_message_cache
 {
 private:
@@ -155,11 +174,11 @@ private:
 
    struct message_hash_index{};
    struct message_contents_hash_index{};
-   struct block_clock_index{};
+   struct insertion_order_index{};
    struct message_info
    {
       message_hash_type message_hash;
-      message           message_body;
+      message_ptr       message_body;
       uint32_t          block_clock_when_received;
 
       /// for network performance stats
@@ -169,41 +188,66 @@ private:
       message_hash_type message_contents_hash;
 
       message_info( const message_hash_type& message_hash,
-                    const message&           message_body,
+                    message_ptr              message_body,
                     uint32_t                 block_clock_when_received,
                     const message_propagation_data& propagation_data,
                     message_hash_type        message_contents_hash ) :
             message_hash( message_hash ),
-            message_body( message_body ),
+            message_body( std::move(message_body) ),
             block_clock_when_received( block_clock_when_received ),
             propagation_data( propagation_data ),
             message_contents_hash( message_contents_hash )
       {}
+
+      /// the number of bytes charged against the cache's budget for this entry
+      size_t size_in_bytes() const { return sizeof(message_info) + message_body->data.size(); }
    };
 
+   // Messages are appended in block clock order, so the front of the sequence is always the oldest entry
    using message_cache_container = boost::multi_index_container < message_info,
                bmi::indexed_by<
-                  bmi::ordered_unique< bmi::tag<message_hash_index>,
-                     bmi::member<message_info, message_hash_type, &message_info::message_hash> >,
-                  bmi::ordered_non_unique< bmi::tag<message_contents_hash_index>,
-                     bmi::member<message_info, message_hash_type, &message_info::message_contents_hash> >,
-                  bmi::ordered_non_unique< bmi::tag<block_clock_index>,
-                     bmi::member<message_info, uint32_t, &message_info::block_clock_when_received> > > >;
+                  bmi::hashed_unique< bmi::tag<message_hash_index>,
+                     bmi::member<message_info, message_hash_type, &message_info::message_hash>,
+                     std::hash<message_hash_type> >,
+                  bmi::hashed_non_unique< bmi::tag<message_contents_hash_index>,
+                     bmi::member<message_info, message_hash_type, &message_info::message_contents_hash>,
+                     std::hash<message_hash_type> >,
+                  bmi::sequenced< bmi::tag<insertion_order_index> > > >;
 
    message_cache_container _message_cache;
 
    uint32_t block_clock = 0;
 
+   size_t _size_in_bytes = 0;
+   size_t _max_size_in_bytes = GRAPHENE_NET_MESSAGE_CACHE_MAX_SIZE_IN_BYTES;
+
+   mutable uint64_t _hits = 0;
+   mutable uint64_t _misses = 0;
+   uint64_t _evicted_by_age = 0;
+   uint64_t _evicted_by_size = 0;
+
+   void evict_oldest();
+   void enforce_size_limit();
+
 public:
    void block_accepted();
-   void cache_message( const message& message_to_cache,
+   void cache_message( message_ptr message_to_cache,
                        const message_hash_type& hash_of_message_to_cache,
                        const message_propagation_data& propagation_data,
                        const message_hash_type& message_content_hash );
-   message get_message( const message_hash_type& hash_of_message_to_lookup ) const;
+   message_ptr get_message( const message_hash_type& hash_of_message_to_lookup ) const;
+   /// looks a message up by what it contains, i.e. a block by its block ID
+   message_ptr get_message_by_contents_hash( const message_hash_type& hash_of_msg_contents_to_lookup ) const;
    message_propagation_data get_message_propagation_data(
          const message_hash_type& hash_of_msg_contents_to_lookup ) const;
    size_t size() const { return _message_cache.size(); }
+   size_t size_in_bytes() const { return _size_in_bytes; }
+
+   size_t get_max_size_in_bytes() const { return _max_size_in_bytes; }
+   void set_max_size_in_bytes( size_t max_size_in_bytes );
+
+   /// sizes, limits and hit/eviction counters, for network_get_info()
+   fc::variant_object get_info() const;
 };
 
 /// When requesting items from peers, we want to prioritize any blocks before
@@ -777,7 +821,7 @@ class node_impl : public peer_connection_delegate, public std::enable_shared_fro
       void                       set_total_bandwidth_limit( uint32_t upload_bytes_per_second, uint32_t download_bytes_per_second );
       void                       disable_peer_advertising();
       fc::variant_object         get_call_statistics() const;
-      message                    get_message_for_item(const item_id& item) override;
+      message_ptr                get_message_for_item(const item_id& item) override;
 
       fc::variant_object         network_get_info() const;
       fc::variant_object         network_get_usage_stats() const;
@@ -31,15 +31,19 @@
 #include <fc/log/logger.hpp>
 #include <fc/network/ip.hpp>
 #include <fc/exception/exception.hpp>
+#include <fc/thread/parallel.hpp>
 
 #include <graphene/net/stcp_socket.hpp>
+#include <graphene/net/config.hpp>
 
 namespace graphene { namespace net {
 
 stcp_socket::stcp_socket()
 //:_buf_len(0)
+   : _send_aes( std::make_shared<fc::aes_encoder>() ),
+     _recv_aes( std::make_shared<fc::aes_decoder>() )
 #ifndef NDEBUG
-   : _read_buffer_in_use(false),
+   , _read_buffer_in_use(false),
      _write_buffer_in_use(false)
 #endif
 {
@@ -62,9 +66,9 @@ void stcp_socket::do_key_exchange()
 
   _shared_secret = _priv_key.get_shared_secret( rpub );
 //    ilog("shared secret ${s}", ("s", shared_secret) );
-  _send_aes.init( fc::sha256::hash( (char*)&_shared_secret, sizeof(_shared_secret) ), 
+  _send_aes->init( fc::sha256::hash( (char*)&_shared_secret, sizeof(_shared_secret) ), 
                   fc::city_hash_crc_128((char*)&_shared_secret,sizeof(_shared_secret) ) );
-  _recv_aes.init( fc::sha256::hash( (char*)&_shared_secret, sizeof(_shared_secret) ), 
+  _recv_aes->init( fc::sha256::hash( (char*)&_shared_secret, sizeof(_shared_secret) ), 
                   fc::city_hash_crc_128((char*)&_shared_secret,sizeof(_shared_secret) ) );
 }
 
@@ -112,7 +116,7 @@ size_t stcp_socket::readsome( char* buffer, size_t len )
       _sock.read(_read_buffer, 16 - (s%16), s);
       s += 16-(s%16);
     }
-    _recv_aes.decode( _read_buffer.get(), s, buffer );
+    _recv_aes->decode( _read_buffer.get(), s, buffer );
     return s;
 } FC_RETHROW_EXCEPTIONS( warn, "", ("len",len) ) }
 
@@ -152,7 +156,7 @@ size_t stcp_socket::writesome( const char* buffer, size_t len )
      * for now because we are going to upgrade to something
      * better.
      */
-    uint32_t ciphertext_len = _send_aes.encode( buffer, len, _write_buffer.get() );
+    uint32_t ciphertext_len = _send_aes->encode( buffer, len, _write_buffer.get() );
     assert(ciphertext_len == len);
     _sock.write( _write_buffer, ciphertext_len );
     return ciphertext_len;
@@ -163,6 +167,61 @@ size_t stcp_socket::writesome( const std::shared_ptr<const char>& buf, size_t le
   return writesome(buf.get() + offset, len);
 }
 
+/**
+ *   Messages are encrypted as one continuous CBC stream, so decrypting a large
+ *   body in a single call yields the same plaintext as decrypting it in 4 KiB
+ *   chunks through readsome().  The body is decrypted in place in a buffer which
+ *   the worker shares, because the calling task may be canceled while the worker
+ *   is still running.  The buffer is handed back to the caller afterwards.
+ */
+void stcp_socket::read_padded( std::vector<char>& data, size_t offset )
+{
+  const size_t len = data.size() - offset;
+  try {
+    assert( (len % 16) == 0 );
+    if( len < GRAPHENE_NET_PARALLEL_CRYPTO_THRESHOLD )
+    {
+      read( data.data() + offset, len );
+      return;
+    }
+
+    auto buffer = std::make_shared<std::vector<char>>( std::move(data) );
+    std::shared_ptr<char> body( buffer, buffer->data() + offset );
+    _sock.read( body, len, 0 );
+
+    auto recv_aes = _recv_aes;
+    fc::do_parallel( [recv_aes,body,len] () {
+      uint32_t plaintext_len = recv_aes->decode( body.get(), len, body.get() );
+      FC_ASSERT( plaintext_len == len );
+    } ).wait();
+    data = std::move( *buffer );
+  } FC_RETHROW_EXCEPTIONS( warn, "", ("len",len) )
+}
+
+void stcp_socket::write_padded( std::vector<char>&& data )
+{
+  const size_t len = data.size();
+  try {
+    assert( (len % 16) == 0 );
+    if( len < GRAPHENE_NET_PARALLEL_CRYPTO_THRESHOLD )
+    {
+      write( data.data(), len );
+      return;
+    }
+
+    // encrypted in place, the socket keeps the buffer alive until it is written
+    auto buffer = std::make_shared<std::vector<char>>( std::move(data) );
+    std::shared_ptr<char> body( buffer, buffer->data() );
+
+    auto send_aes = _send_aes;
+    fc::do_parallel( [send_aes,body,len] () {
+      uint32_t ciphertext_len = send_aes->encode( body.get(), len, body.get() );
+      FC_ASSERT( ciphertext_len == len );
+    } ).wait();
+    _sock.write( body, len, 0 );
+  } FC_RETHROW_EXCEPTIONS( warn, "", ("len",len) )
+}
+
 void stcp_socket::flush()
 {
   _sock.flush();
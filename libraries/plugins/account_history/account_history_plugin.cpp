@@ -322,13 +322,18 @@ void account_history_plugin::plugin_set_program_options(
          ("extended-history-by-registrar",
           boost::program_options::value<std::vector<std::string>>()->composing()->multitoken(),
           "Track longer history for accounts with this registrar (may specify multiple times)")
+         ("operation-history-hash-index", boost::program_options::value<bool>(),
+          "Look up operations in memory by ID through a hash map, faster but uses more memory (default: false)")
          ;
    cfg.add(cli);
 }
 
 void account_history_plugin::plugin_initialize(const boost::program_options::variables_map& options)
 {
-   database().applied_block.connect( [&]( const signed_block& b){ my->update_account_histories(b); } );
+   database().applied_block.connect( [&]( const signed_block& b){
+      block_tracer::scoped_span span( database().get_recording_block_tracer(), "account_history.applied_block" );
+      my->update_account_histories(b);
+   } );
    my->_oho_index = database().add_index< primary_index< operation_history_index > >();
    database().add_index< primary_index< account_transaction_history_index > >();
 
@@ -347,6 +352,9 @@ void account_history_plugin::plugin_initialize(const boost::program_options::var
                   graphene::chain::account_id_type);
    LOAD_VALUE_SET(options, "extended-history-by-registrar", my->_extended_history_registrars,
                   graphene::chain::account_id_type);
+   if (options.count("operation-history-hash-index") > 0 && options["operation-history-hash-index"].as<bool>()) {
+       my->_oho_index->use_hash_index(); // ids of untracked or pruned operations are skipped
+   }
 }
 
 void account_history_plugin::plugin_startup()
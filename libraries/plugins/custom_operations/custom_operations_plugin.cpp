@@ -139,6 +139,7 @@ void custom_operations_plugin::plugin_initialize(const boost::program_options::v
    }
 
    database().applied_block.connect( [this]( const signed_block& b) {
+      block_tracer::scoped_span span( database().get_recording_block_tracer(), "custom_operations.applied_block" );
       if( b.block_num() >= my->_start_block )
          my->onBlock();
    } );
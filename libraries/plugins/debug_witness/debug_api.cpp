@@ -14,6 +14,8 @@
 #include <graphene/debug_witness/debug_api.hpp>
 #include <graphene/debug_witness/debug_witness.hpp>
 
+#include <graphene/witness/witness.hpp>
+
 namespace graphene { namespace debug_witness {
 
 namespace detail {
@@ -28,6 +30,10 @@ class debug_api_impl
       void debug_update_object( const fc::variant_object& update );
       void debug_stream_json_objects( const std::string& filename );
       void debug_stream_json_objects_flush();
+      fc::variant debug_get_block_production_timings();
+      void debug_enable_profiler( bool enabled );
+      fc::variant debug_get_profile();
+      void debug_dump_profile( const std::string& filename );
       std::shared_ptr< graphene::debug_witness_plugin::debug_witness_plugin > get_plugin();
 
       graphene::app::application& app;
@@ -121,6 +127,30 @@ void debug_api_impl::debug_stream_json_objects_flush()
    get_plugin()->flush_json_object_stream();
 }
 
+fc::variant debug_api_impl::debug_get_block_production_timings()
+{
+   auto witness = app.get_plugin< graphene::witness_plugin::witness_plugin >( "witness" );
+   FC_ASSERT( witness, "The witness plugin is not enabled" );
+   const auto& timings = witness->get_block_production_timings();
+   return fc::variant( std::vector< graphene::witness_plugin::block_production_timing >( timings.begin(),
+                                                                                        timings.end() ), 2 );
+}
+
+void debug_api_impl::debug_enable_profiler( bool enabled )
+{
+   app.chain_database()->enable_execution_profiler( enabled );
+}
+
+fc::variant debug_api_impl::debug_get_profile()
+{
+   return fc::variant( app.chain_database()->get_execution_profiler().get_profile(), GRAPHENE_MAX_NESTED_OBJECTS );
+}
+
+void debug_api_impl::debug_dump_profile( const std::string& filename )
+{
+   app.chain_database()->get_execution_profiler().dump_profile( fc::path( filename ) );
+}
+
 } // detail
 
 debug_api::debug_api( graphene::app::application& app )
@@ -153,5 +183,25 @@ void debug_api::debug_stream_json_objects_flush()
    my->debug_stream_json_objects_flush();
 }
 
+fc::variant debug_api::debug_get_block_production_timings()
+{
+   return my->debug_get_block_production_timings();
+}
+
+void debug_api::debug_enable_profiler( bool enabled )
+{
+   my->debug_enable_profiler( enabled );
+}
+
+fc::variant debug_api::debug_get_profile()
+{
+   return my->debug_get_profile();
+}
+
+void debug_api::debug_dump_profile( std::string filename )
+{
+   my->debug_dump_profile( filename );
+}
+
 
 } } // graphene::debug_witness
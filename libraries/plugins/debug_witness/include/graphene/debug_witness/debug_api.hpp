@@ -82,6 +82,29 @@ class debug_api
        */
       void debug_stream_json_objects_flush();
 
+      /**
+       * Get the timing of the most recent blocks produced by the witness plugin of this node, oldest first.
+       * Durations are in microseconds.
+       */
+      fc::variant debug_get_block_production_timings();
+
+      /**
+       * Enable or disable the execution profiler of the database. Enabling it discards the data collected so far.
+       */
+      void debug_enable_profiler( bool enabled );
+
+      /**
+       * Get the data collected by the execution profiler: execution time histograms per operation type,
+       * object changes per index of the most recent blocks and the slowest transactions.
+       * Durations are in microseconds.
+       */
+      fc::variant debug_get_profile();
+
+      /**
+       * Save the data collected by the execution profiler to a file in JSON format.
+       */
+      void debug_dump_profile( std::string filename );
+
       std::shared_ptr< detail::debug_api_impl > my;
 };
 
@@ -93,4 +116,8 @@ FC_API(graphene::debug_witness::debug_api,
        (debug_update_object)
        (debug_stream_json_objects)
        (debug_stream_json_objects_flush)
+       (debug_get_block_production_timings)
+       (debug_enable_profiler)
+       (debug_get_profile)
+       (debug_dump_profile)
      )
@@ -31,18 +31,103 @@
 #include <fc/rpc/websocket_api.hpp>
 #include <fc/api.hpp>
 
+#include <deque>
+
 namespace graphene { namespace delayed_node {
 namespace bpo = boost::program_options;
 
 namespace detail {
 struct delayed_node_plugin_impl {
+   using block_batch = std::vector<fc::optional<graphene::chain::signed_block>>;
+   using block_batch_ptr = std::shared_ptr<block_batch>;
+
+   /// number of blocks requested from the trusted node at once
+   static constexpr uint32_t blocks_per_request = 100;
+   /// number of requests kept in flight while syncing
+   static constexpr uint32_t max_requests_in_flight = 4;
+
    std::string remote_endpoint;
    fc::http::websocket_client client;
    std::shared_ptr<fc::rpc::websocket_api_connection> client_connection;
    fc::api<graphene::app::database_api> database_api;
+   /// only available if the trusted node grants us access to its block_api
+   fc::optional<fc::api<graphene::app::block_api>> block_api;
    boost::signals2::scoped_connection client_connection_closed;
    graphene::chain::block_id_type last_received_remote_head;
    graphene::chain::block_id_type last_processed_remote_head;
+
+   /**
+    * Requests blocks first..last from the trusted node and precomputes them once they have arrived,
+    * so that several batches can be downloaded and precomputed while an earlier one is being applied.
+    */
+   fc::future<block_batch_ptr> request_blocks( const graphene::chain::database& db, uint32_t first, uint32_t last )
+   {
+      auto db_api = database_api;
+      auto blk_api = block_api;
+      return fc::async( [&db,db_api,blk_api,first,last]() {
+         auto blocks = std::make_shared<block_batch>();
+         if( blk_api )
+            *blocks = (*blk_api)->get_blocks( first, last );
+         else
+         {
+            blocks->reserve( last - first + 1 );
+            for( uint32_t block_num = first; block_num <= last; ++block_num )
+               blocks->push_back( db_api->get_block( block_num ) );
+         }
+         FC_ASSERT( blocks->size() == last - first + 1, "Trusted node returned an unexpected number of blocks" );
+         for( const auto& block : *blocks )
+         {
+            FC_ASSERT( block, "Trusted node claims it has blocks it doesn't actually have." );
+            db.precompute_parallel( *block, graphene::chain::database::skip_nothing ).wait();
+         }
+         return blocks;
+      }, "delayed_node request_blocks" );
+   }
+
+   /// Fetches and applies all blocks up to last_block_num, returns the number of blocks applied
+   uint32_t sync_blocks( graphene::chain::database& db, uint32_t last_block_num )
+   {
+      const fc::time_point start_time = fc::time_point::now();
+      fc::time_point last_report_time = start_time;
+      uint32_t applied_blocks = 0;
+
+      std::deque<fc::future<block_batch_ptr>> requests;
+      uint32_t next_block_to_request = db.head_block_num() + 1;
+      auto fill_pipeline = [&]() {
+         while( requests.size() < max_requests_in_flight && next_block_to_request <= last_block_num )
+         {
+            uint32_t last = std::min( last_block_num, next_block_to_request + blocks_per_request - 1 );
+            requests.push_back( request_blocks( db, next_block_to_request, last ) );
+            next_block_to_request = last + 1;
+         }
+      };
+
+      fill_pipeline();
+      while( !requests.empty() )
+      {
+         block_batch_ptr blocks = requests.front().wait();
+         requests.pop_front();
+         fill_pipeline();
+
+         for( const auto& block : *blocks )
+         {
+            db.push_block( *block );
+            ++applied_blocks;
+         }
+
+         const fc::time_point now = fc::time_point::now();
+         if( now - last_report_time >= fc::seconds(10) || requests.empty() )
+         {
+            const double elapsed_seconds = std::max<int64_t>( (now - start_time).count(), 1 ) / 1000000.0;
+            ilog( "Delayed node pushed ${n} blocks (head #${h}, ${r} remaining) at ${s} blocks/s",
+                  ("n", applied_blocks)("h", db.head_block_num())
+                  ("r", last_block_num - db.head_block_num())
+                  ("s", uint64_t( applied_blocks / elapsed_seconds )) );
+            last_report_time = now;
+         }
+      }
+      return applied_blocks;
+   }
 };
 }
 
@@ -58,7 +143,8 @@ void delayed_node_plugin::plugin_set_program_options(bpo::options_description& c
 {
    cli.add_options()
          ("trusted-node", boost::program_options::value<std::string>(),
-          "RPC endpoint of a trusted validating node (required for delayed_node)")
+          "RPC endpoint of a trusted validating node (required for delayed_node). "
+          "Syncing is much faster if the node grants access to block_api")
          ;
    cfg.add(cli);
 }
@@ -79,6 +165,17 @@ void delayed_node_plugin::connect()
    my->client_connection = std::make_shared<fc::rpc::websocket_api_connection>(
            con, GRAPHENE_NET_MAX_NESTED_OBJECTS );
    my->database_api = my->client_connection->get_remote_api<graphene::app::database_api>(0);
+   try
+   {
+      auto login = my->client_connection->get_remote_api<graphene::app::login_api>(1);
+      my->block_api = login->block();
+   }
+   catch( const fc::exception& e )
+   {
+      my->block_api.reset();
+      wlog( "Trusted node does not grant access to block_api, syncing will fetch blocks one at a time: ${e}",
+            ("e", e.to_string()) );
+   }
    my->database_api->set_block_applied_callback([this]( const fc::variant& block_id )
    {
       fc::from_variant( block_id, my->last_received_remote_head, GRAPHENE_MAX_NESTED_OBJECTS );
@@ -116,16 +213,7 @@ void delayed_node_plugin::sync_with_trusted_node()
          break;
       }
       pass_count++;
-      while( remote_dpo.last_irreversible_block_num > db.head_block_num() )
-      {
-         fc::optional<graphene::chain::signed_block> block = my->database_api->get_block( db.head_block_num()+1 );
-         // TODO: during sync, decouple requesting blocks from preprocessing + applying them
-         FC_ASSERT(block, "Trusted node claims it has blocks it doesn't actually have.");
-         ilog("Pushing block #${n}", ("n", block->block_num()));
-         db.precompute_parallel( *block, graphene::chain::database::skip_nothing ).wait();
-         db.push_block(*block);
-         synced_blocks++;
-      }
+      synced_blocks += my->sync_blocks( db, remote_dpo.last_irreversible_block_num );
    }
 }
 
@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2026 BitShares Blockchain Foundation, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <graphene/delta_stream/delta_stream_plugin.hpp>
+
+#include <graphene/chain/global_property_object.hpp>
+#include <graphene/chain/operation_history_object.hpp>
+
+#include <fc/filesystem.hpp>
+#include <fc/io/json.hpp>
+
+#include <cstdio>
+#include <deque>
+#include <fstream>
+
+namespace graphene { namespace delta_stream {
+
+namespace detail
+{
+
+class delta_stream_plugin_impl
+{
+   public:
+      explicit delta_stream_plugin_impl( delta_stream_plugin& _plugin );
+      virtual ~delta_stream_plugin_impl();
+
+      void on_block( const signed_block& b );
+      void on_objects_updated( const vector<object_id_type>& ids );
+      void on_objects_removed( const vector<object_id_type>& ids );
+
+      /// writes the record of the most recently applied block unless that has already happened
+      void write_pending_block();
+      /// loads where the stream of an earlier run ended
+      void load_state();
+      void close();
+
+      graphene::chain::database& database()
+      {
+         return _self.database();
+      }
+
+      friend class graphene::delta_stream::delta_stream_plugin;
+
+   private:
+      /// starts a new file if the current one is full, files only start with the records of a block
+      void prepare_file( uint32_t block_num );
+      void write_record( const fc::variant& record );
+      void open_file( uint32_t first_block_num );
+      void save_state();
+      /// removes all files and starts the stream over, for when the chain is applied again from genesis
+      void restart_stream();
+
+      delta_stream_plugin& _self;
+
+      fc::path _directory;
+      uint64_t _max_file_size = 256 * 1024 * 1024;
+      uint32_t _max_files = 0;
+      bool _include_operations = true;
+      bool _include_objects = true;
+
+      std::ofstream _file;
+      uint64_t _file_size = 0;
+      std::deque<fc::path> _files;
+
+      fc::optional<fc::mutable_variant_object> _pending_block;
+      fc::variants _pending_objects;
+      fc::variants _pending_removed;
+      uint32_t _pending_irreversible_block_num = 0;
+
+      fc::optional<uint32_t> _last_block_num;
+      block_id_type _last_block_id;
+      uint32_t _last_irreversible_block_num = 0;
+
+      boost::signals2::scoped_connection _applied_block_conn;
+      boost::signals2::scoped_connection _new_objects_conn;
+      boost::signals2::scoped_connection _changed_objects_conn;
+      boost::signals2::scoped_connection _removed_objects_conn;
+      boost::signals2::scoped_connection _changed_objects_notified_conn;
+
+      fc::path state_file()const
+      {
+         return _directory / "delta_stream_state.json";
+      }
+};
+
+delta_stream_plugin_impl::delta_stream_plugin_impl( delta_stream_plugin& _plugin ) :
+   _self( _plugin )
+{ }
+
+delta_stream_plugin_impl::~delta_stream_plugin_impl()
+{
+   try
+   {
+      close();
+   }
+   catch( const fc::exception& e )
+   {
+      wlog( "Error while closing the delta stream: ${e}", ("e", e.to_detail_string()) );
+   }
+}
+
+void delta_stream_plugin_impl::on_block( const signed_block& b )
+{
+   write_pending_block();
+
+   const uint32_t block_num = b.block_num();
+   // After a restart blocks may be applied again which an earlier run has streamed already.
+   // Irreversible ones can not have changed and are skipped, the others are replaced after a fork record.
+   if( block_num == 1 && _last_block_num.valid() )
+      restart_stream();
+   else if( block_num <= _last_irreversible_block_num )
+      return;
+   else if( _last_block_num.valid() && block_num == *_last_block_num + 1 && b.previous != _last_block_id )
+      wlog( "Block ${n} does not follow the last block in the delta stream ${id}",
+            ("n", block_num)("id", _last_block_id) );
+
+   if( _last_block_num.valid() && block_num <= *_last_block_num )
+   {
+      fc::mutable_variant_object fork;
+      fork["type"] = "fork";
+      fork["num"] = block_num - 1;
+      prepare_file( block_num );
+      write_record( fork );
+   }
+   _last_block_num = block_num;
+   _last_block_id = b.id();
+
+   fc::mutable_variant_object record;
+   record["type"] = "block";
+   record["num"] = block_num;
+   record["id"] = fc::variant( b.id(), 1 );
+   record["timestamp"] = fc::variant( b.timestamp, 1 );
+   if( _include_operations )
+   {
+      fc::variants operations;
+      for( const optional<operation_history_object>& op : database().get_applied_operations() )
+      {
+         if( op.valid() )
+            operations.emplace_back( *op, GRAPHENE_MAX_NESTED_OBJECTS );
+      }
+      record["operations"] = std::move( operations );
+   }
+   // the object notifications of this block follow, the record is written after them
+   _pending_block = std::move( record );
+   _pending_irreversible_block_num = database().get_dynamic_global_properties().last_irreversible_block_num;
+}
+
+void delta_stream_plugin_impl::on_objects_updated( const vector<object_id_type>& ids )
+{
+   if( !_pending_block.valid() || !_include_objects )
+      return;
+   const auto& db = database();
+   for( const object_id_type& id : ids )
+   {
+      // serialize right away, pending transactions are applied on top of this state later
+      const object* obj = db.find_object( id );
+      if( obj != nullptr )
+         _pending_objects.emplace_back( obj->to_variant() );
+   }
+}
+
+void delta_stream_plugin_impl::on_objects_removed( const vector<object_id_type>& ids )
+{
+   if( !_pending_block.valid() || !_include_objects )
+      return;
+   for( const object_id_type& id : ids )
+      _pending_removed.emplace_back( id, 1 );
+}
+
+void delta_stream_plugin_impl::write_pending_block()
+{
+   if( !_pending_block.valid() )
+      return;
+
+   fc::mutable_variant_object record = std::move( *_pending_block );
+   _pending_block.reset();
+   const uint32_t block_num = record["num"].as_uint64();
+   if( _include_objects )
+   {
+      record["objects"] = std::move( _pending_objects );
+      record["removed"] = std::move( _pending_removed );
+   }
+   _pending_objects.clear();
+   _pending_removed.clear();
+   prepare_file( block_num );
+   write_record( record );
+
+   if( _pending_irreversible_block_num > _last_irreversible_block_num )
+   {
+      _last_irreversible_block_num = _pending_irreversible_block_num;
+      fc::mutable_variant_object irreversible;
+      irreversible["type"] = "irreversible";
+      irreversible["num"] = _last_irreversible_block_num;
+      write_record( irreversible );
+   }
+   _file.flush();
+   save_state();
+}
+
+void delta_stream_plugin_impl::save_state()
+{
+   fc::mutable_variant_object state;
+   state["block_num"] = *_last_block_num;
+   state["block_id"] = fc::variant( _last_block_id, 1 );
+   state["last_irreversible_block_num"] = _last_irreversible_block_num;
+
+   // replaced in one step, so that a crash never leaves a partial state behind
+   const fc::path temp_file = state_file().generic_string() + ".tmp";
+   fc::json::save_to_file( fc::variant( state ), temp_file );
+   fc::rename( temp_file, state_file() );
+}
+
+void delta_stream_plugin_impl::load_state()
+{
+   if( !fc::exists( state_file() ) )
+      return;
+   const fc::variant state = fc::json::from_file( state_file() );
+   _last_block_num = static_cast<uint32_t>( state["block_num"].as_uint64() );
+   _last_block_id = state["block_id"].as<block_id_type>( 1 );
+   _last_irreversible_block_num = static_cast<uint32_t>( state["last_irreversible_block_num"].as_uint64() );
+   ilog( "delta_stream: continuing after block ${n}", ("n", *_last_block_num) );
+}
+
+void delta_stream_plugin_impl::restart_stream()
+{
+   ilog( "delta_stream: the chain is applied from genesis, removing the existing stream files" );
+   if( _file.is_open() )
+      _file.close();
+   for( fc::directory_iterator itr( _directory ), end; itr != end; ++itr )
+   {
+      const fc::path file = *itr;
+      if( file.filename().generic_string().compare( 0, 7, "deltas-" ) == 0 )
+         fc::remove( file );
+   }
+   fc::remove_all( state_file() );
+   _files.clear();
+   _last_block_num.reset();
+   _last_irreversible_block_num = 0;
+}
+
+void delta_stream_plugin_impl::prepare_file( uint32_t block_num )
+{
+   if( !_file.is_open() || _file_size >= _max_file_size )
+      open_file( block_num );
+}
+
+void delta_stream_plugin_impl::write_record( const fc::variant& record )
+{
+   std::string line = fc::json::to_string( record, fc::json::stringify_large_ints_and_doubles,
+                                           GRAPHENE_MAX_NESTED_OBJECTS );
+   line += '\n';
+   _file.write( line.data(), line.size() );
+   FC_ASSERT( _file.good(), "Unable to write to delta stream file ${f}", ("f", _files.back()) );
+   _file_size += line.size();
+}
+
+void delta_stream_plugin_impl::open_file( uint32_t first_block_num )
+{
+   if( _file.is_open() )
+      _file.close();
+
+   // files are named after their first block, so that they sort in stream order
+   char name[32];
+   std::snprintf( name, sizeof(name), "deltas-%010u.jsonl", first_block_num );
+   const fc::path file_name = _directory / name;
+
+   _file.open( file_name.generic_string(), std::ofstream::binary | std::ofstream::out | std::ofstream::app );
+   FC_ASSERT( _file.is_open(), "Unable to open delta stream file ${f}", ("f", file_name) );
+   _file_size = fc::file_size( file_name );
+   _files.push_back( file_name );
+
+   // only files written by this process are pruned
+   while( _max_files > 0 && _files.size() > _max_files )
+   {
+      fc::remove( _files.front() );
+      _files.pop_front();
+   }
+}
+
+void delta_stream_plugin_impl::close()
+{
+   write_pending_block();
+   if( _file.is_open() )
+      _file.close();
+}
+
+} // end namespace detail
+
+delta_stream_plugin::delta_stream_plugin(graphene::app::application& app) :
+   plugin(app),
+   my( std::make_unique<detail::delta_stream_plugin_impl>(*this) )
+{
+   // Nothing else to do
+}
+
+delta_stream_plugin::~delta_stream_plugin() = default;
+
+std::string delta_stream_plugin::plugin_name()const
+{
+   return "delta_stream";
+}
+std::string delta_stream_plugin::plugin_description()const
+{
+   return "Writes a fork-aware stream of per-block object deltas and operations to files.";
+}
+
+void delta_stream_plugin::plugin_set_program_options(
+   boost::program_options::options_description& cli,
+   boost::program_options::options_description& cfg
+   )
+{
+   cli.add_options()
+         ("delta-stream-dir", boost::program_options::value<std::string>(),
+               "Directory to write the delta stream files to (required for delta_stream)")
+         ("delta-stream-file-size", boost::program_options::value<uint32_t>(),
+               "Start a new delta stream file once the current one exceeds this many MiB(256)")
+         ("delta-stream-max-files", boost::program_options::value<uint32_t>(),
+               "Delete the oldest delta stream files written by this process beyond this number, 0 keeps all(0)")
+         ("delta-stream-operations", boost::program_options::value<bool>(),
+               "Include the operations of each block(true)")
+         ("delta-stream-objects", boost::program_options::value<bool>(),
+               "Include the objects created, changed and removed by each block(true)")
+         ;
+   cfg.add(cli);
+}
+
+void delta_stream_plugin::plugin_initialize(const boost::program_options::variables_map& options)
+{ try {
+   FC_ASSERT( options.count("delta-stream-dir") > 0, "The delta_stream plugin requires delta-stream-dir" );
+   my->_directory = options["delta-stream-dir"].as<std::string>();
+   if( options.count("delta-stream-file-size") > 0 )
+      my->_max_file_size = uint64_t( options["delta-stream-file-size"].as<uint32_t>() ) * 1024 * 1024;
+   if( options.count("delta-stream-max-files") > 0 )
+      my->_max_files = options["delta-stream-max-files"].as<uint32_t>();
+   if( options.count("delta-stream-operations") > 0 )
+      my->_include_operations = options["delta-stream-operations"].as<bool>();
+   if( options.count("delta-stream-objects") > 0 )
+      my->_include_objects = options["delta-stream-objects"].as<bool>();
+
+   fc::create_directories( my->_directory );
+   my->load_state();
+
+   my->_applied_block_conn = database().applied_block.connect( [this]( const signed_block& b ) {
+      block_tracer::scoped_span span( database().get_recording_block_tracer(), "delta_stream.applied_block" );
+      my->on_block( b );
+   } );
+   my->_new_objects_conn = database().new_objects.connect( [this]( const vector<object_id_type>& ids,
+                                                                   const flat_set<account_id_type>& ) {
+      block_tracer::scoped_span span( database().get_recording_block_tracer(), "delta_stream.new_objects" );
+      my->on_objects_updated( ids );
+   } );
+   my->_changed_objects_conn = database().changed_objects.connect( [this]( const vector<object_id_type>& ids,
+                                                                           const flat_set<account_id_type>& ) {
+      block_tracer::scoped_span span( database().get_recording_block_tracer(), "delta_stream.changed_objects" );
+      my->on_objects_updated( ids );
+   } );
+   my->_removed_objects_conn = database().removed_objects.connect( [this]( const vector<object_id_type>& ids,
+                                                                           const vector<const object*>&,
+                                                                           const flat_set<account_id_type>& ) {
+      block_tracer::scoped_span span( database().get_recording_block_tracer(), "delta_stream.removed_objects" );
+      my->on_objects_removed( ids );
+   } );
+   my->_changed_objects_notified_conn = database().changed_objects_notified.connect( [this]() {
+      block_tracer::scoped_span span( database().get_recording_block_tracer(),
+                                      "delta_stream.changed_objects_notified" );
+      my->write_pending_block();
+   } );
+} FC_LOG_AND_RETHROW() }
+
+void delta_stream_plugin::plugin_startup()
+{
+   ilog("delta_stream: writing to ${d}", ("d", my->_directory));
+}
+
+void delta_stream_plugin::plugin_shutdown()
+{
+   my->close();
+}
+
+} }
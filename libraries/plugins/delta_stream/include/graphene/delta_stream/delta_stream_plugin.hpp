@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 BitShares Blockchain Foundation, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/app/plugin.hpp>
+#include <graphene/chain/database.hpp>
+
+namespace graphene { namespace delta_stream {
+using namespace chain;
+
+namespace detail
+{
+    class delta_stream_plugin_impl;
+}
+
+/**
+ * Writes an ordered stream of per-block object deltas and operations to rotating files of
+ * JSON lines, so that any number of external indexers can follow the chain at their own pace.
+ *
+ * Every line is one record:
+ * - <tt>{"type":"block","num":..,"id":..,"timestamp":..,"operations":[..],"objects":[..],"removed":[..]}</tt>
+ *   holds everything the block changed, objects hold their complete state after the block;
+ * - <tt>{"type":"fork","num":n}</tt> means that all blocks above n were popped, the blocks
+ *   of the new fork follow;
+ * - <tt>{"type":"irreversible","num":n}</tt> means that block n and all blocks below it can
+ *   no longer be popped.
+ *
+ * Object deltas are only available while the undo database is enabled, i.e. not during replay.
+ *
+ * The last streamed block is kept in a state file next to the stream, so that a restarted node
+ * continues the stream. Blocks which are applied again after the restart are skipped if they were
+ * irreversible, the others are written again after a fork record. If the chain is applied from
+ * genesis again, e.g. after a resync, the existing files are removed and the stream starts over.
+ */
+class delta_stream_plugin : public graphene::app::plugin
+{
+   public:
+      explicit delta_stream_plugin(graphene::app::application& app);
+      ~delta_stream_plugin() override;
+
+      std::string plugin_name()const override;
+      std::string plugin_description()const override;
+      void plugin_set_program_options(
+         boost::program_options::options_description& cli,
+         boost::program_options::options_description& cfg) override;
+      void plugin_initialize(const boost::program_options::variables_map& options) override;
+      void plugin_startup() override;
+      void plugin_shutdown() override;
+
+   private:
+      std::unique_ptr<detail::delta_stream_plugin_impl> my;
+};
+
+} } //graphene::delta_stream
@@ -490,6 +490,8 @@ void elasticsearch_plugin::plugin_set_program_options(
                "Save operation as string. Needed to serve history api calls(false)")
          ("elasticsearch-mode", boost::program_options::value<uint16_t>(),
                "Mode of operation: only_save(0), only_query(1), all(2) - Default: 0")
+         ("elasticsearch-operation-hash-index", boost::program_options::value<bool>(),
+               "Look up operations kept in memory by ID through a hash map, uses more memory(false)")
          ;
    cfg.add(cli);
 }
@@ -532,6 +534,10 @@ void elasticsearch_plugin::plugin_initialize(const boost::program_options::varia
          FC_THROW_EXCEPTION(graphene::chain::plugin_exception, "Elasticsearch mode not valid");
       my->_elasticsearch_mode = static_cast<mode>(options["elasticsearch-mode"].as<uint16_t>());
    }
+   if (options.count("elasticsearch-operation-hash-index") > 0
+         && options["elasticsearch-operation-hash-index"].as<bool>()) {
+      my->_oho_index->use_hash_index(); // ids of pruned operations are skipped
+   }
 
    if(my->_elasticsearch_mode != mode::only_query) {
       if (my->_elasticsearch_mode == mode::all && !my->_elasticsearch_operation_string)
@@ -539,6 +545,7 @@ void elasticsearch_plugin::plugin_initialize(const boost::program_options::varia
                "If elasticsearch-mode is set to all then elasticsearch-operation-string need to be true");
 
       database().applied_block.connect([this](const signed_block &b) {
+         block_tracer::scoped_span span( database().get_recording_block_tracer(), "elasticsearch.applied_block" );
          if (!my->update_account_histories(b))
             FC_THROW_EXCEPTION(graphene::chain::plugin_exception,
                   "Error populating ES database, we are going to keep trying.");
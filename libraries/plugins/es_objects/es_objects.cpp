@@ -50,6 +50,8 @@ class es_objects_plugin_impl
       virtual ~es_objects_plugin_impl();
 
       bool index_database(const vector<object_id_type>& ids, std::string action);
+      bool on_objects_notified();
+      bool flush_on_shutdown();
       bool genesis();
       void remove_from_database(object_id_type id, std::string index);
 
@@ -66,6 +68,7 @@ class es_objects_plugin_impl
       bool _es_objects_asset_bitasset = true;
       std::string _es_objects_index_prefix = "objects-";
       uint32_t _es_objects_start_es_after_block = 0;
+      uint32_t _es_objects_coalesce_blocks = 1;
       CURL *curl; // curl handler
       vector <std::string> bulk;
       vector<std::string> prepare;
@@ -75,9 +78,19 @@ class es_objects_plugin_impl
       uint32_t block_number;
       fc::time_point_sec block_time;
 
+      /// objects touched since the last flush, mapped to whether they have been removed
+      std::map<object_id_type, bool> pending_objects;
+      uint32_t blocks_since_flush = 0;
+
    private:
+      bool is_tracked(const object_id_type& id)const;
+      void flush_pending_objects();
+      bool send_bulk();
+      void send_object(const object_id_type& id, bool removed);
+      template<typename T>
+      void send_object(const object_id_type& id, bool removed, const string& index_name);
       template<typename T>
-      void prepareTemplate(T blockchain_object, string index_name);
+      void prepareTemplate(const T& blockchain_object, string index_name);
 };
 
 bool es_objects_plugin_impl::genesis()
@@ -127,6 +140,22 @@ bool es_objects_plugin_impl::genesis()
    return true;
 }
 
+bool es_objects_plugin_impl::is_tracked(const object_id_type& id)const
+{
+   return ( id.is<proposal_object>() && _es_objects_proposals )
+       || ( id.is<account_object>() && _es_objects_accounts )
+       || ( id.is<asset_object>() && _es_objects_assets )
+       || ( id.is<account_balance_object>() && _es_objects_balances )
+       || ( id.is<limit_order_object>() && _es_objects_limit_orders )
+       || ( id.is<asset_bitasset_data_object>() && _es_objects_asset_bitasset );
+}
+
+/**
+ * When only the current state is kept, changes are just recorded here and the objects are serialized
+ * when the pending set is flushed in on_objects_notified(), so an object that is touched several times
+ * in the meantime is sent once, in its latest state, and removing an object cancels any pending update.
+ * Otherwise every version is a document of its own and is serialized right away.
+ */
 bool es_objects_plugin_impl::index_database(const vector<object_id_type>& ids, std::string action)
 {
    graphene::chain::database &db = _self.database();
@@ -135,91 +164,110 @@ bool es_objects_plugin_impl::index_database(const vector<object_id_type>& ids, s
    block_number = db.head_block_num();
 
    if(block_number > _es_objects_start_es_after_block) {
+      const bool removed = ( action == "delete" );
+      for (auto const &value: ids) {
+         if (!is_tracked(value))
+            continue;
+         if (_es_objects_keep_only_current)
+            pending_objects[value] = removed;
+         else
+            send_object(value, removed);
+      }
+   }
 
-      // check if we are in replay or in sync and change number of bulk documents accordingly
-      uint32_t limit_documents = 0;
-      if ((fc::time_point::now() - block_time) < fc::seconds(30))
-         limit_documents = _es_objects_bulk_sync;
-      else
-         limit_documents = _es_objects_bulk_replay;
+   return true;
+}
 
+bool es_objects_plugin_impl::on_objects_notified()
+{
+   graphene::chain::database &db = _self.database();
 
-      for (auto const &value: ids) {
-         if (value.is<proposal_object>() && _es_objects_proposals) {
-            auto obj = db.find_object(value);
-            auto p = static_cast<const proposal_object *>(obj);
-            if (p != nullptr) {
-               if (action == "delete")
-                  remove_from_database(p->id, "proposal");
-               else
-                  prepareTemplate<proposal_object>(*p, "proposal");
-            }
-         } else if (value.is<account_object>() && _es_objects_accounts) {
-            auto obj = db.find_object(value);
-            auto a = static_cast<const account_object *>(obj);
-            if (a != nullptr) {
-               if (action == "delete")
-                  remove_from_database(a->id, "account");
-               else
-                  prepareTemplate<account_object>(*a, "account");
-            }
-         } else if (value.is<asset_object>() && _es_objects_assets) {
-            auto obj = db.find_object(value);
-            auto a = static_cast<const asset_object *>(obj);
-            if (a != nullptr) {
-               if (action == "delete")
-                  remove_from_database(a->id, "asset");
-               else
-                  prepareTemplate<asset_object>(*a, "asset");
-            }
-         } else if (value.is<account_balance_object>() && _es_objects_balances) {
-            auto obj = db.find_object(value);
-            auto b = static_cast<const account_balance_object *>(obj);
-            if (b != nullptr) {
-               if (action == "delete")
-                  remove_from_database(b->id, "balance");
-               else
-                  prepareTemplate<account_balance_object>(*b, "balance");
-            }
-         } else if (value.is<limit_order_object>() && _es_objects_limit_orders) {
-            auto obj = db.find_object(value);
-            auto l = static_cast<const limit_order_object *>(obj);
-            if (l != nullptr) {
-               if (action == "delete")
-                  remove_from_database(l->id, "limitorder");
-               else
-                  prepareTemplate<limit_order_object>(*l, "limitorder");
-            }
-         } else if (value.is<asset_bitasset_data_object>() && _es_objects_asset_bitasset) {
-            auto obj = db.find_object(value);
-            auto ba = static_cast<const asset_bitasset_data_object *>(obj);
-            if (ba != nullptr) {
-               if (action == "delete")
-                  remove_from_database(ba->id, "bitasset");
-               else
-                  prepareTemplate<asset_bitasset_data_object>(*ba, "bitasset");
-            }
-         }
-      }
+   block_time = db.head_block_time();
+   block_number = db.head_block_num();
 
-      if (curl && bulk.size() >= limit_documents) { // we are in bulk time, ready to add data to elasticsearech
+   // check if we are in replay or in sync and change number of bulk documents accordingly
+   const bool in_sync = ( (fc::time_point::now() - block_time) < fc::seconds(30) );
+   uint32_t limit_documents = in_sync ? _es_objects_bulk_sync : _es_objects_bulk_replay;
 
-         graphene::utilities::ES es;
-         es.curl = curl;
-         es.bulk_lines = bulk;
-         es.elasticsearch_url = _es_objects_elasticsearch_url;
-         es.auth = _es_objects_auth;
+   // all changes of this block have been recorded
+   ++blocks_since_flush;
+   if (blocks_since_flush >= _es_objects_coalesce_blocks)
+      flush_pending_objects();
 
-         if (!graphene::utilities::SendBulk(std::move(es)))
-            return false;
-         else
-            bulk.clear();
-      }
-   }
+   if (bulk.size() >= limit_documents) // we are in bulk time, ready to add data to elasticsearech
+      return send_bulk();
 
    return true;
 }
 
+/**
+ * Sends whatever is still pending or buffered, so that changes collected since the last bulk are not lost
+ * on a clean shutdown.
+ */
+bool es_objects_plugin_impl::flush_on_shutdown()
+{
+   if (!pending_objects.empty())
+      flush_pending_objects();
+   return send_bulk();
+}
+
+bool es_objects_plugin_impl::send_bulk()
+{
+   if (!curl || bulk.empty())
+      return true;
+
+   graphene::utilities::ES es;
+   es.curl = curl;
+   es.bulk_lines = bulk;
+   es.elasticsearch_url = _es_objects_elasticsearch_url;
+   es.auth = _es_objects_auth;
+
+   if (!graphene::utilities::SendBulk(std::move(es)))
+      return false;
+
+   bulk.clear();
+   return true;
+}
+
+/**
+ * Serializes the pending objects in their current state, after the object notifications of the latest block.
+ * The removed flag is only a hint: after a fork switch an object recorded as removed may exist again, so the
+ * database decides whether a document is updated or deleted.
+ */
+void es_objects_plugin_impl::flush_pending_objects()
+{
+   for (const auto& item : pending_objects)
+      send_object(item.first, item.second);
+   pending_objects.clear();
+   blocks_since_flush = 0;
+}
+
+void es_objects_plugin_impl::send_object(const object_id_type& id, bool removed)
+{
+   if (id.is<proposal_object>())
+      send_object<proposal_object>(id, removed, "proposal");
+   else if (id.is<account_object>())
+      send_object<account_object>(id, removed, "account");
+   else if (id.is<asset_object>())
+      send_object<asset_object>(id, removed, "asset");
+   else if (id.is<account_balance_object>())
+      send_object<account_balance_object>(id, removed, "balance");
+   else if (id.is<limit_order_object>())
+      send_object<limit_order_object>(id, removed, "limitorder");
+   else if (id.is<asset_bitasset_data_object>())
+      send_object<asset_bitasset_data_object>(id, removed, "bitasset");
+}
+
+template<typename T>
+void es_objects_plugin_impl::send_object(const object_id_type& id, bool removed, const string& index_name)
+{
+   auto obj = _self.database().find_object(id);
+   if (obj != nullptr)
+      prepareTemplate<T>(*static_cast<const T *>(obj), index_name);
+   else if (removed)
+      remove_from_database(id, index_name);
+}
+
 void es_objects_plugin_impl::remove_from_database( object_id_type id, std::string index)
 {
    if(_es_objects_keep_only_current)
@@ -237,7 +285,7 @@ void es_objects_plugin_impl::remove_from_database( object_id_type id, std::strin
 }
 
 template<typename T>
-void es_objects_plugin_impl::prepareTemplate(T blockchain_object, string index_name)
+void es_objects_plugin_impl::prepareTemplate(const T& blockchain_object, string index_name)
 {
    fc::mutable_variant_object bulk_header;
    bulk_header["_index"] = _es_objects_index_prefix + index_name;
@@ -316,6 +364,9 @@ void es_objects_plugin::plugin_set_program_options(
                "Keep only current state of the objects(true)")
          ("es-objects-start-es-after-block", boost::program_options::value<uint32_t>(),
                "Start doing ES job after block(0)")
+         ("es-objects-coalesce-blocks", boost::program_options::value<uint32_t>(),
+               "Number of blocks to collect changes for before the latest version of each object is prepared "
+               "for sending, only applies with es-objects-keep-only-current(1)")
          ;
    cfg.add(cli);
 }
@@ -361,8 +412,12 @@ void es_objects_plugin::plugin_initialize(const boost::program_options::variable
    if (options.count("es-objects-start-es-after-block") > 0) {
       my->_es_objects_start_es_after_block = options["es-objects-start-es-after-block"].as<uint32_t>();
    }
+   if (options.count("es-objects-coalesce-blocks") > 0) {
+      my->_es_objects_coalesce_blocks = options["es-objects-coalesce-blocks"].as<uint32_t>();
+   }
 
    database().applied_block.connect([this](const signed_block &b) {
+      block_tracer::scoped_span span( database().get_recording_block_tracer(), "es_objects.applied_block" );
       if(b.block_num() == 1 && my->_es_objects_start_es_after_block == 0) {
          if (!my->genesis())
             FC_THROW_EXCEPTION(graphene::chain::plugin_exception, "Error populating genesis data.");
@@ -370,6 +425,7 @@ void es_objects_plugin::plugin_initialize(const boost::program_options::variable
    });
    database().new_objects.connect([this]( const vector<object_id_type>& ids,
          const flat_set<account_id_type>& impacted_accounts ) {
+      block_tracer::scoped_span span( database().get_recording_block_tracer(), "es_objects.new_objects" );
       if(!my->index_database(ids, "create"))
       {
          FC_THROW_EXCEPTION(graphene::chain::plugin_exception,
@@ -378,6 +434,7 @@ void es_objects_plugin::plugin_initialize(const boost::program_options::variable
    });
    database().changed_objects.connect([this]( const vector<object_id_type>& ids,
          const flat_set<account_id_type>& impacted_accounts ) {
+      block_tracer::scoped_span span( database().get_recording_block_tracer(), "es_objects.changed_objects" );
       if(!my->index_database(ids, "update"))
       {
          FC_THROW_EXCEPTION(graphene::chain::plugin_exception,
@@ -386,12 +443,22 @@ void es_objects_plugin::plugin_initialize(const boost::program_options::variable
    });
    database().removed_objects.connect([this](const vector<object_id_type>& ids,
          const vector<const object*>& objs, const flat_set<account_id_type>& impacted_accounts) {
+      block_tracer::scoped_span span( database().get_recording_block_tracer(), "es_objects.removed_objects" );
       if(!my->index_database(ids, "delete"))
       {
          FC_THROW_EXCEPTION(graphene::chain::plugin_exception,
                "Error deleting object from ES database, we are going to keep trying.");
       }
    });
+   database().changed_objects_notified.connect([this]() {
+      block_tracer::scoped_span span( database().get_recording_block_tracer(),
+                                      "es_objects.changed_objects_notified" );
+      if (!my->on_objects_notified())
+      {
+         FC_THROW_EXCEPTION(graphene::chain::plugin_exception,
+               "Error sending objects to ES database, we are going to keep trying.");
+      }
+   });
 }
 
 void es_objects_plugin::plugin_startup()
@@ -407,4 +474,10 @@ void es_objects_plugin::plugin_startup()
    ilog("elasticsearch OBJECTS: plugin_startup() begin");
 }
 
+void es_objects_plugin::plugin_shutdown()
+{
+   if (!my->flush_on_shutdown())
+      elog("elasticsearch OBJECTS: error sending the remaining objects to ES database on shutdown");
+}
+
 } }
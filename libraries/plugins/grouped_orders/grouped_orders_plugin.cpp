@@ -31,6 +31,8 @@ namespace graphene { namespace grouped_orders {
 namespace detail
 {
 
+class limit_order_group_index;
+
 class grouped_orders_plugin_impl
 {
    public:
@@ -42,8 +44,11 @@ class grouped_orders_plugin_impl
          return _self.database();
       }
 
+      void on_applied_block();
+
       grouped_orders_plugin&     _self;
       flat_set<uint16_t>         _tracked_groups;
+      limit_order_group_index*   _groups = nullptr;
 };
 
 /**
@@ -52,7 +57,7 @@ class grouped_orders_plugin_impl
 class limit_order_group_index : public secondary_index
 {
    public:
-      limit_order_group_index( const flat_set<uint16_t>& groups ) : _tracked_groups( groups ) {};
+      explicit limit_order_group_index( const flat_set<uint16_t>& groups ) : _tracked_groups( groups ) {};
 
       virtual void object_inserted( const object& obj ) override;
       virtual void object_removed( const object& obj ) override;
@@ -62,33 +67,93 @@ class limit_order_group_index : public secondary_index
       const flat_set<uint16_t>& get_tracked_groups() const
       { return _tracked_groups; }
 
-      const map< limit_order_group_key, limit_order_group_data >& get_order_groups() const
-      { return _og_data; }
+      const limit_order_group_book* get_book( const limit_order_group_book_key& key ) const
+      {
+         auto itr = _books.find( key );
+         return itr == _books.end() ? nullptr : &itr->second;
+      }
+
+      /// @return the changes since the previous call
+      vector< limit_order_group_book_diff > take_changes();
+
+      void clear_changes()
+      { _changed_groups.clear(); }
 
    private:
       void remove_order( const limit_order_object& obj, bool remove_empty = true );
 
+      void insert_group( const limit_order_group_book_key& book_key, limit_order_group_book& book,
+                         const price& min_price, const limit_order_group_data& data );
+      void set_min_price( const limit_order_group_book_key& book_key, limit_order_group_book& book,
+                          limit_order_group_book::iterator itr, const price& min_price );
+
+      void mark_changed( const limit_order_group_book_key& book_key, const price& min_price )
+      { _changed_groups[ book_key ].insert( min_price ); }
+
+      static bool entry_less( const limit_order_group_entry& entry, const limit_order_group_key& key )
+      { return entry.first < key; }
+
       /** tracked groups */
       flat_set<uint16_t> _tracked_groups;
 
-      /** maps the group key to group data */
-      map< limit_order_group_key, limit_order_group_data > _og_data;
+      /** maps the group size and market to the order groups */
+      map< limit_order_group_book_key, limit_order_group_book > _books;
+
+      /** min_price of the order groups changed since the last call to take_changes(), by book */
+      map< limit_order_group_book_key, flat_set<price> > _changed_groups;
 };
 
+void limit_order_group_index::insert_group( const limit_order_group_book_key& book_key, limit_order_group_book& book,
+                                            const price& min_price, const limit_order_group_data& data )
+{
+   limit_order_group_key key( book_key.group, min_price );
+   auto itr = std::lower_bound( book.begin(), book.end(), key, entry_less );
+   if( itr != book.end() && itr->first == key )
+   {  // should not happen, merge into the existing group
+      if( itr->second.max_price < data.max_price )
+         itr->second.max_price = data.max_price;
+      itr->second.total_for_sale += data.total_for_sale;
+   }
+   else
+      book.emplace( itr, key, data );
+   mark_changed( book_key, min_price );
+}
+
+void limit_order_group_index::set_min_price( const limit_order_group_book_key& book_key, limit_order_group_book& book,
+                                             limit_order_group_book::iterator itr, const price& min_price )
+{
+   mark_changed( book_key, itr->first.min_price );
+   limit_order_group_key key( book_key.group, min_price );
+   // groups do not overlap, so usually the group can stay where it is
+   if( ( itr == book.begin() || std::prev( itr )->first < key )
+         && ( std::next( itr ) == book.end() || key < std::next( itr )->first ) )
+   {
+      itr->first = key;
+      mark_changed( book_key, min_price );
+   }
+   else
+   {
+      limit_order_group_data data = itr->second;
+      book.erase( itr );
+      insert_group( book_key, book, min_price, data );
+   }
+}
+
 void limit_order_group_index::object_inserted( const object& objct )
 { try {
    const limit_order_object& o = static_cast<const limit_order_object&>( objct );
 
-   auto& idx = _og_data;
-
    for( uint16_t group : get_tracked_groups() )
    {
+      const limit_order_group_book_key book_key( group, o.sell_price.base.asset_id, o.sell_price.quote.asset_id );
+      auto& book = _books[ book_key ];
+
       auto create_ogo = [&]() {
-         idx[ limit_order_group_key( group, o.sell_price ) ] = limit_order_group_data( o.sell_price, o.for_sale );
+         insert_group( book_key, book, o.sell_price, limit_order_group_data( o.sell_price, o.for_sale ) );
       };
-      // if idx is empty, insert this order
+      // if the book is empty, insert this order
       // Note: not capped
-      if( idx.empty() )
+      if( book.empty() )
       {
          create_ogo();
          continue;
@@ -110,15 +175,13 @@ void limit_order_group_index::object_inserted( const object& objct )
          capped_price = min;
          capped_min = true;
       }
-      // if idx is not empty, find the group that is next to this order
-      auto itr = idx.lower_bound( limit_order_group_key( group, capped_price ) );
+      // if the book is not empty, find the group that is next to this order
+      auto itr = std::lower_bound( book.begin(), book.end(), limit_order_group_key( group, capped_price ),
+                                   entry_less );
       bool check_previous = false;
-      if( itr == idx.end() || itr->first.group != group
-            || itr->first.min_price.base.asset_id != o.sell_price.base.asset_id
-            || itr->first.min_price.quote.asset_id != o.sell_price.quote.asset_id )
-         // not same market or group type
+      if( itr == book.end() )
          check_previous = true;
-      else // same market and group type
+      else
       {
          bool update_max = false;
          if( capped_price > itr->second.max_price ) // implies itr->min_price <= itr->max_price < max
@@ -131,55 +194,44 @@ void limit_order_group_index::object_inserted( const object& objct )
          }
          if( !check_previous ) // new order is within the range
          {
+            itr->second.total_for_sale += o.for_sale;
             if( capped_min && o.sell_price < itr->first.min_price )
-            {  // need to update itr->min_price here, if itr is below min, and new order is even lower
-               // TODO improve performance
-               limit_order_group_data data( itr->second.max_price, o.for_sale + itr->second.total_for_sale );
-               idx.erase( itr );
-               idx[ limit_order_group_key( group, o.sell_price ) ] = data;
-            }
+               // need to update itr->min_price here, if itr is below min, and new order is even lower
+               set_min_price( book_key, book, itr, o.sell_price );
             else
             {
                if( update_max || ( capped_max && o.sell_price > itr->second.max_price ) )
                   itr->second.max_price = o.sell_price; // store real price here, not capped
-               itr->second.total_for_sale += o.for_sale;
+               mark_changed( book_key, itr->first.min_price );
             }
          }
       }
 
       if( check_previous )
       {
-         if( itr == idx.begin() ) // no previous
+         if( itr == book.begin() ) // no previous
             create_ogo();
          else
          {
             --itr; // should be valid
-            if( itr->first.group != group || itr->first.min_price.base.asset_id != o.sell_price.base.asset_id
-                                          || itr->first.min_price.quote.asset_id != o.sell_price.quote.asset_id )
-               // not same market or group type
+            // due to lower_bound, always true: capped_price < itr->first.min_price, so no need to check again,
+            // if new order is in range of itr group, always need to update itr->first.min_price, unless
+            //   o.sell_price is higher than max
+            price min_price = itr->second.max_price / ratio_type( GRAPHENE_100_PERCENT + group, GRAPHENE_100_PERCENT );
+            // min_price should have been capped here
+            if( capped_price < min_price ) // new order is out of range
                create_ogo();
-            else // same market and group type
-            {
-               // due to lower_bound, always true: capped_price < itr->first.min_price, so no need to check again,
-               // if new order is in range of itr group, always need to update itr->first.min_price, unless
-               //   o.sell_price is higher than max
-               price min_price = itr->second.max_price / ratio_type( GRAPHENE_100_PERCENT + group, GRAPHENE_100_PERCENT );
-               // min_price should have been capped here
-               if( capped_price < min_price ) // new order is out of range
-                  create_ogo();
-               else if( capped_max && o.sell_price >= itr->first.min_price )
-               {  // itr is above max, and price of new order is even higher
-                  if( o.sell_price > itr->second.max_price )
-                     itr->second.max_price = o.sell_price;
-                  itr->second.total_for_sale += o.for_sale;
-               }
-               else
-               {  // new order is within the range
-                  // TODO improve performance
-                  limit_order_group_data data( itr->second.max_price, o.for_sale + itr->second.total_for_sale );
-                  idx.erase( itr );
-                  idx[ limit_order_group_key( group, o.sell_price ) ] = data;
-               }
+            else if( capped_max && o.sell_price >= itr->first.min_price )
+            {  // itr is above max, and price of new order is even higher
+               if( o.sell_price > itr->second.max_price )
+                  itr->second.max_price = o.sell_price;
+               itr->second.total_for_sale += o.for_sale;
+               mark_changed( book_key, itr->first.min_price );
+            }
+            else
+            {  // new order is within the range
+               itr->second.total_for_sale += o.for_sale;
+               set_min_price( book_key, book, itr, o.sell_price );
             }
          }
       }
@@ -205,16 +257,22 @@ void limit_order_group_index::object_modified( const object& objct )
 
 void limit_order_group_index::remove_order( const limit_order_object& o, bool remove_empty )
 {
-   auto& idx = _og_data;
-
    for( uint16_t group : get_tracked_groups() )
    {
+      const limit_order_group_book_key book_key( group, o.sell_price.base.asset_id, o.sell_price.quote.asset_id );
+      auto book_itr = _books.find( book_key );
+      if( book_itr == _books.end() )
+      {
+         // can not find corresponding group, should not happen
+         wlog( "can not find the order group containing order for removing (market dismatch): ${o}", ("o",o) );
+         continue;
+      }
+      auto& book = book_itr->second;
+
       // find the group that should contain this order
-      auto itr = idx.lower_bound( limit_order_group_key( group, o.sell_price ) );
-      if( itr == idx.end() || itr->first.group != group
-            || itr->first.min_price.base.asset_id != o.sell_price.base.asset_id
-            || itr->first.min_price.quote.asset_id != o.sell_price.quote.asset_id
-            || itr->second.max_price < o.sell_price )
+      auto itr = std::lower_bound( book.begin(), book.end(), limit_order_group_key( group, o.sell_price ),
+                                   entry_less );
+      if( itr == book.end() || itr->second.max_price < o.sell_price )
       {
          // can not find corresponding group, should not happen
          wlog( "can not find the order group containing order for removing (price dismatch): ${o}", ("o",o) );
@@ -225,13 +283,66 @@ void limit_order_group_index::remove_order( const limit_order_object& o, bool re
          if( itr->second.total_for_sale < o.for_sale )
             // should not happen
             wlog( "can not find the order group containing order for removing (amount dismatch): ${o}", ("o",o) );
-         else if( !remove_empty || itr->second.total_for_sale > o.for_sale )
-            itr->second.total_for_sale -= o.for_sale;
          else
-            // it's the only order in the group and need to be removed
-            idx.erase( itr );
+         {
+            mark_changed( book_key, itr->first.min_price );
+            if( !remove_empty || itr->second.total_for_sale > o.for_sale )
+               itr->second.total_for_sale -= o.for_sale;
+            else
+            {
+               // it's the only order in the group and need to be removed
+               book.erase( itr );
+               if( book.empty() )
+                  _books.erase( book_itr );
+            }
+         }
+      }
+   }
+}
+
+vector< limit_order_group_book_diff > limit_order_group_index::take_changes()
+{
+   vector< limit_order_group_book_diff > result;
+   result.reserve( _changed_groups.size() );
+   for( const auto& item : _changed_groups )
+   {
+      limit_order_group_book_diff diff;
+      diff.group = item.first.group;
+      diff.base = item.first.base;
+      diff.quote = item.first.quote;
+      const limit_order_group_book* book = get_book( item.first );
+      // prices are in ascending order while the book is in descending order
+      for( auto price_itr = item.second.rbegin(); price_itr != item.second.rend(); ++price_itr )
+      {
+         if( book != nullptr )
+         {
+            limit_order_group_key key( item.first.group, *price_itr );
+            auto itr = std::lower_bound( book->begin(), book->end(), key, entry_less );
+            if( itr != book->end() && itr->first == key )
+            {
+               diff.changed.push_back( *itr );
+               continue;
+            }
+         }
+         diff.removed.push_back( *price_itr );
       }
+      result.push_back( std::move( diff ) );
    }
+   _changed_groups.clear();
+   return result;
+}
+
+/** note: this method cannot yield because it is called in the middle of applying a block. */
+void grouped_orders_plugin_impl::on_applied_block()
+{
+   if( _self.limit_order_groups_changed.empty() )
+   {
+      _groups->clear_changes();
+      return;
+   }
+   auto diffs = _groups->take_changes();
+   if( !diffs.empty() )
+      _self.limit_order_groups_changed( diffs );
 }
 
 } // end namespace detail
@@ -283,6 +394,13 @@ void grouped_orders_plugin::plugin_startup()
                                                    detail::limit_order_group_index >( my->_tracked_groups );
    for( const auto& order : database().get_index_type< limit_order_index >().indices() )
       groups.object_inserted( order );
+   groups.clear_changes();
+   my->_groups = &groups;
+
+   database().applied_block.connect( [this]( const signed_block& ) {
+      block_tracer::scoped_span span( database().get_recording_block_tracer(), "grouped_orders.applied_block" );
+      my->on_applied_block();
+   } );
 }
 
 const flat_set<uint16_t>& grouped_orders_plugin::tracked_groups() const
@@ -290,12 +408,13 @@ const flat_set<uint16_t>& grouped_orders_plugin::tracked_groups() const
    return my->_tracked_groups;
 }
 
-const map< limit_order_group_key, limit_order_group_data >& grouped_orders_plugin::limit_order_groups()
+const limit_order_group_book* grouped_orders_plugin::limit_order_groups( uint16_t group, asset_id_type base,
+                                                                         asset_id_type quote )
 {
    const auto& idx = database().get_index_type< limit_order_index >();
    const auto& pidx = dynamic_cast<const primary_index< limit_order_index >&>(idx);
    const auto& logidx = pidx.get_secondary_index< detail::limit_order_group_index >();
-   return logidx.get_order_groups();
+   return logidx.get_book( limit_order_group_book_key( group, base, quote ) );
 }
 
 } }
@@ -57,6 +57,43 @@ struct limit_order_group_data
    share_type    total_for_sale; ///< asset id is min_price.base.asset_id
 };
 
+/// an order group, i.e. an entry of a grouped order book
+using limit_order_group_entry = std::pair< limit_order_group_key, limit_order_group_data >;
+
+/**
+ * The order groups of one group size in one market, ordered by min_price descendingly, i.e. from the best
+ * offered price to the worst, so that a depth snapshot is a slice of the array.
+ */
+using limit_order_group_book = vector< limit_order_group_entry >;
+
+struct limit_order_group_book_key
+{
+   limit_order_group_book_key( const uint16_t g, const asset_id_type b, const asset_id_type q )
+   : group(g), base(b), quote(q) {}
+   limit_order_group_book_key() {}
+
+   uint16_t      group = 0;
+   asset_id_type base;  ///< asset being sold
+   asset_id_type quote; ///< asset being purchased
+
+   friend bool operator < ( const limit_order_group_book_key& a, const limit_order_group_book_key& b )
+   {
+      return std::tie( a.group, a.base, a.quote ) < std::tie( b.group, b.base, b.quote );
+   }
+};
+
+/**
+ * Changes of a grouped order book since the previous block
+ */
+struct limit_order_group_book_diff
+{
+   uint16_t      group = 0;
+   asset_id_type base;
+   asset_id_type quote;
+   vector< limit_order_group_entry > changed; ///< groups that have been created or updated, in book order
+   vector< price >                   removed; ///< min_price of the groups that no longer exist
+};
+
 namespace detail
 {
     class grouped_orders_plugin_impl;
@@ -82,7 +119,14 @@ class grouped_orders_plugin : public graphene::app::plugin
 
       const flat_set<uint16_t>&   tracked_groups()const;
 
-      const map< limit_order_group_key, limit_order_group_data >& limit_order_groups();
+      /// @return the order groups of a market, or nullptr if there is no order in it
+      const limit_order_group_book* limit_order_groups( uint16_t group, asset_id_type base, asset_id_type quote );
+
+      /**
+       * Emitted after each block with the changes of the grouped order books since the previous block.
+       * It is emitted in the middle of applying the block, so handlers must not yield.
+       */
+      boost::signals2::signal< void( const vector<limit_order_group_book_diff>& ) > limit_order_groups_changed;
 
    private:
       std::unique_ptr<detail::grouped_orders_plugin_impl> my;
@@ -92,3 +136,4 @@ class grouped_orders_plugin : public graphene::app::plugin
 
 FC_REFLECT( graphene::grouped_orders::limit_order_group_key, (group)(min_price) )
 FC_REFLECT( graphene::grouped_orders::limit_order_group_data, (max_price)(total_for_sale) )
+FC_REFLECT( graphene::grouped_orders::limit_order_group_book_diff, (group)(base)(quote)(changed)(removed) )
@@ -40,6 +40,49 @@ namespace graphene { namespace market_history {
 namespace detail
 {
 
+/// Returns a + b, or the maximum value of share_type if it overflows
+static share_type saturated_add( const share_type& a, const share_type& b )
+{
+   try {
+      return a + b;
+   } catch( fc::overflow_exception& ) {
+      return std::numeric_limits<int64_t>::max();
+   }
+}
+
+/**
+ * Collects the effect of all maker fills in a block on the OHLCV buckets, so that every bucket
+ * object is looked up, created or modified at most once per block instead of once per fill.
+ */
+class pending_buckets
+{
+   public:
+      void add_fill( const bucket_key& key, const price& trade_price, const price& fill_price );
+
+      /// Resets the state, writes the collected data to the bucket objects and removes expired buckets
+      void apply( database& db, fc::time_point_sec now, uint32_t max_history );
+
+   private:
+      struct pending_bucket
+      {
+         pending_bucket( const bucket_key& k, const price& trade_price, const price& fill_price )
+         : key(k), open(fill_price), high(fill_price), low(fill_price), close(fill_price),
+           base_volume(trade_price.base.amount), quote_volume(trade_price.quote.amount) {}
+
+         bucket_key key;
+         price      open;
+         price      high;
+         price      low;
+         price      close;
+         share_type base_volume;
+         share_type quote_volume;
+      };
+
+      /// in the order of first fill
+      std::vector<pending_bucket>  _buckets;
+      flat_map<bucket_key, size_t> _index;
+};
+
 class market_history_plugin_impl
 {
    public:
@@ -65,6 +108,7 @@ class market_history_plugin_impl
       uint32_t                   _maximum_history_per_bucket_size = 1000;
       uint32_t                   _max_order_his_records_per_market = 1000;
       uint32_t                   _max_order_his_seconds_per_market = 259200;
+      pending_buckets            _pending_buckets;
 };
 
 
@@ -73,9 +117,11 @@ struct operation_process_fill_order
    market_history_plugin&            _plugin;
    fc::time_point_sec                _now;
    const market_ticker_meta_object*& _meta;
+   pending_buckets&                  _pending;
 
-   operation_process_fill_order( market_history_plugin& mhp, fc::time_point_sec n, const market_ticker_meta_object*& meta )
-   :_plugin(mhp),_now(n),_meta(meta) {}
+   operation_process_fill_order( market_history_plugin& mhp, fc::time_point_sec n, const market_ticker_meta_object*& meta,
+                                 pending_buckets& pending )
+   :_plugin(mhp),_now(n),_meta(meta),_pending(pending) {}
 
    typedef void result_type;
 
@@ -205,94 +251,110 @@ struct operation_process_fill_order
          });
       }
 
-      // To update buckets data
-      const auto max_history = _plugin.max_history();
-      if( max_history == 0 ) return;
-
-      const auto& buckets = _plugin.tracked_buckets();
-      if( buckets.size() == 0 ) return;
+      // To update buckets data, collected here and applied once per block
+      if( _plugin.max_history() == 0 )
+         return;
 
-      const auto& bucket_idx = db.get_index_type<bucket_index>();
-      for( auto bucket : buckets )
+      for( auto bucket : _plugin.tracked_buckets() )
       {
-          auto bucket_num = _now.sec_since_epoch() / bucket;
-          fc::time_point_sec cutoff;
-          if( bucket_num > max_history )
-             cutoff = cutoff + ( bucket * ( bucket_num - max_history ) );
-
-          key.seconds = bucket;
-          key.open    = fc::time_point_sec() + ( bucket_num * bucket );
-
-          const auto& by_key_idx = bucket_idx.indices().get<by_key>();
-          auto bucket_itr = by_key_idx.find( key );
-          if( bucket_itr == by_key_idx.end() )
-          { // create new bucket
-            /* const auto& obj = */
-            db.create<bucket_object>( [&]( bucket_object& b ){
-                 b.key = key;
-                 b.base_volume = trade_price.base.amount;
-                 b.quote_volume = trade_price.quote.amount;
-                 b.open_base = fill_price.base.amount;
-                 b.open_quote = fill_price.quote.amount;
-                 b.close_base = fill_price.base.amount;
-                 b.close_quote = fill_price.quote.amount;
-                 b.high_base = b.close_base;
-                 b.high_quote = b.close_quote;
-                 b.low_base = b.close_base;
-                 b.low_quote = b.close_quote;
-            });
-            //wlog( "    creating bucket ${b}", ("b",obj) );
-          }
-          else
-          { // update existing bucket
-             //wlog( "    before updating bucket ${b}", ("b",*bucket_itr) );
-             db.modify( *bucket_itr, [&]( bucket_object& b ){
-                  try {
-                     b.base_volume += trade_price.base.amount;
-                  } catch( fc::overflow_exception& ) {
-                     b.base_volume = std::numeric_limits<int64_t>::max();
-                  }
-                  try {
-                     b.quote_volume += trade_price.quote.amount;
-                  } catch( fc::overflow_exception& ) {
-                     b.quote_volume = std::numeric_limits<int64_t>::max();
-                  }
-                  b.close_base = fill_price.base.amount;
-                  b.close_quote = fill_price.quote.amount;
-                  if( b.high() < fill_price )
-                  {
-                      b.high_base = b.close_base;
-                      b.high_quote = b.close_quote;
-                  }
-                  if( b.low() > fill_price )
-                  {
-                      b.low_base = b.close_base;
-                      b.low_quote = b.close_quote;
-                  }
-             });
-             //wlog( "    after bucket bucket ${b}", ("b",*bucket_itr) );
-          }
-
-          {
-             key.open = fc::time_point_sec();
-             bucket_itr = by_key_idx.lower_bound( key );
-
-             while( bucket_itr != by_key_idx.end() &&
-                    bucket_itr->key.base == key.base &&
-                    bucket_itr->key.quote == key.quote &&
-                    bucket_itr->key.seconds == bucket &&
-                    bucket_itr->key.open < cutoff )
-             {
-              //  elog( "    removing old bucket ${b}", ("b", *bucket_itr) );
-                auto old_bucket_itr = bucket_itr;
-                ++bucket_itr;
-                db.remove( *old_bucket_itr );
-             }
-          }
+         key.seconds = bucket;
+         key.open    = fc::time_point_sec() + ( _now.sec_since_epoch() / bucket * bucket );
+         _pending.add_fill( key, trade_price, fill_price );
       }
    }
 };
 
+void pending_buckets::add_fill( const bucket_key& key, const price& trade_price, const price& fill_price )
+{
+   auto itr = _index.find( key );
+   if( itr == _index.end() )
+   {
+      _index[key] = _buckets.size();
+      _buckets.emplace_back( key, trade_price, fill_price );
+      return;
+   }
+
+   pending_bucket& b = _buckets[itr->second];
+   b.base_volume  = saturated_add( b.base_volume,  trade_price.base.amount );
+   b.quote_volume = saturated_add( b.quote_volume, trade_price.quote.amount );
+   b.close = fill_price;
+   if( b.high < fill_price )
+      b.high = fill_price;
+   if( b.low > fill_price )
+      b.low = fill_price;
+}
+
+void pending_buckets::apply( database& db, fc::time_point_sec now, uint32_t max_history )
+{
+   std::vector<pending_bucket> buckets;
+   buckets.swap( _buckets );
+   _index.clear();
+
+   const auto& by_key_idx = db.get_index_type<bucket_index>().indices().get<by_key>();
+
+   // Buckets are created in the order they were first touched, so object IDs are the same as if
+   // every fill had been applied one by one
+   for( const pending_bucket& p : buckets )
+   {
+      auto bucket_itr = by_key_idx.find( p.key );
+      if( bucket_itr == by_key_idx.end() )
+      { // create new bucket
+         db.create<bucket_object>( [&p]( bucket_object& b ){
+            b.key = p.key;
+            b.base_volume = p.base_volume;
+            b.quote_volume = p.quote_volume;
+            b.open_base = p.open.base.amount;
+            b.open_quote = p.open.quote.amount;
+            b.close_base = p.close.base.amount;
+            b.close_quote = p.close.quote.amount;
+            b.high_base = p.high.base.amount;
+            b.high_quote = p.high.quote.amount;
+            b.low_base = p.low.base.amount;
+            b.low_quote = p.low.quote.amount;
+         });
+      }
+      else
+      { // update existing bucket
+         db.modify( *bucket_itr, [&p]( bucket_object& b ){
+            b.base_volume = saturated_add( b.base_volume, p.base_volume );
+            b.quote_volume = saturated_add( b.quote_volume, p.quote_volume );
+            b.close_base = p.close.base.amount;
+            b.close_quote = p.close.quote.amount;
+            if( b.high() < p.high )
+            {
+               b.high_base = p.high.base.amount;
+               b.high_quote = p.high.quote.amount;
+            }
+            if( b.low() > p.low )
+            {
+               b.low_base = p.low.base.amount;
+               b.low_quote = p.low.quote.amount;
+            }
+         });
+      }
+
+      // All fills in a block share one timestamp, so there is only one pending bucket per market and
+      // bucket size, and old buckets are removed at most once per block
+      const uint32_t bucket = p.key.seconds;
+      const auto bucket_num = now.sec_since_epoch() / bucket;
+      fc::time_point_sec cutoff;
+      if( bucket_num > max_history )
+         cutoff = cutoff + ( bucket * ( bucket_num - max_history ) );
+
+      bucket_itr = by_key_idx.lower_bound( bucket_key( p.key.base, p.key.quote, bucket, fc::time_point_sec() ) );
+      while( bucket_itr != by_key_idx.end() &&
+             bucket_itr->key.base == p.key.base &&
+             bucket_itr->key.quote == p.key.quote &&
+             bucket_itr->key.seconds == bucket &&
+             bucket_itr->key.open < cutoff )
+      {
+         auto old_bucket_itr = bucket_itr;
+         ++bucket_itr;
+         db.remove( *old_bucket_itr );
+      }
+   }
+}
+
 void market_history_plugin_impl::update_market_histories( const signed_block& b )
 {
    graphene::chain::database& db = database();
@@ -315,12 +377,17 @@ void market_history_plugin_impl::update_market_histories( const signed_block& b
          // process market history
          try
          {
-            o_op->op.visit( operation_process_fill_order( _self, b.timestamp, _meta ) );
+            o_op->op.visit( operation_process_fill_order( _self, b.timestamp, _meta, _pending_buckets ) );
          } FC_CAPTURE_AND_LOG( (o_op) )
          // process liquidity pool history
          update_liquidity_pool_histories( b.timestamp, *o_op, _lp_meta );
       }
    }
+   // apply the accumulated bucket updates
+   try
+   {
+      _pending_buckets.apply( db, b.timestamp, _maximum_history_per_bucket_size );
+   } FC_CAPTURE_AND_LOG( (b.block_num()) )
    // roll out expired data from ticker
    if( _meta != nullptr )
    {
@@ -766,7 +833,10 @@ void market_history_plugin::plugin_set_program_options(
 
 void market_history_plugin::plugin_initialize(const boost::program_options::variables_map& options)
 { try {
-   database().applied_block.connect( [this]( const signed_block& b){ my->update_market_histories(b); } );
+   database().applied_block.connect( [this]( const signed_block& b){
+      block_tracer::scoped_span span( database().get_recording_block_tracer(), "market_history.applied_block" );
+      my->update_market_histories(b);
+   } );
 
    database().add_index< primary_index< bucket_index  > >();
    database().add_index< primary_index< history_index  > >();
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026 BitShares Blockchain Foundation, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/app/plugin.hpp>
+#include <graphene/chain/database.hpp>
+
+namespace graphene { namespace metrics {
+using namespace chain;
+
+namespace detail
+{
+    class metrics_plugin_impl;
+}
+
+/**
+ * Serves node internals in the Prometheus text exposition format at <tt>http://metrics-endpoint/metrics</tt>:
+ * block latency and processing time, the pending transaction pool, the undo stack, object counts and memory
+ * estimates per index, and per-peer p2p traffic and send queues.
+ *
+ * The endpoint is meant to be scraped from the local host or a private network only.
+ */
+class metrics_plugin : public graphene::app::plugin
+{
+   public:
+      explicit metrics_plugin(graphene::app::application& app);
+      ~metrics_plugin() override;
+
+      std::string plugin_name()const override;
+      std::string plugin_description()const override;
+      void plugin_set_program_options(
+         boost::program_options::options_description& cli,
+         boost::program_options::options_description& cfg) override;
+      void plugin_initialize(const boost::program_options::variables_map& options) override;
+      void plugin_startup() override;
+      void plugin_shutdown() override;
+
+      /// @return all the metrics in the Prometheus text exposition format
+      std::string render_metrics()const;
+
+   private:
+      std::unique_ptr<detail::metrics_plugin_impl> my;
+};
+
+} } //graphene::metrics
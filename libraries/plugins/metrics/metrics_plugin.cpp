@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2026 BitShares Blockchain Foundation, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <graphene/metrics/metrics_plugin.hpp>
+
+#include <graphene/chain/global_property_object.hpp>
+#include <graphene/net/node.hpp>
+
+#include <fc/network/http/server.hpp>
+#include <fc/network/ip.hpp>
+
+#include <sstream>
+#include <vector>
+
+namespace graphene { namespace metrics {
+
+namespace detail
+{
+
+/// Upper bounds of the buckets of the block latency histogram, in seconds
+constexpr double latency_bucket_bounds[] = { 0.1, 0.25, 0.5, 1, 1.5, 2, 3, 5, 10, 30 };
+/// Upper bounds of the buckets of the block apply duration histogram, in seconds
+constexpr double apply_bucket_bounds[] = { 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1 };
+
+static void write_header( std::ostream& out, const char* name, const char* type, const char* help )
+{
+   out << "# HELP " << name << ' ' << help << '\n'
+       << "# TYPE " << name << ' ' << type << '\n';
+}
+
+template<typename T>
+static void write_metric( std::ostream& out, const char* name, const char* type, const char* help, const T& value )
+{
+   write_header( out, name, type, help );
+   out << name << ' ' << value << '\n';
+}
+
+static double to_seconds( const fc::microseconds& us )
+{
+   return double( us.count() ) / 1000000;
+}
+
+/// A histogram with fixed buckets
+class histogram
+{
+   public:
+      template<size_t N>
+      explicit histogram( const double (&bounds)[N] )
+      : _bounds( bounds, bounds + N ), _bucket_counts( N + 1, 0 )
+      { }
+
+      void observe( double value )
+      {
+         size_t bucket = 0;
+         while( bucket < _bounds.size() && value > _bounds[bucket] )
+            ++bucket;
+         ++_bucket_counts[bucket];
+         ++_count;
+         _sum += value;
+      }
+
+      void render( std::ostream& out, const char* name, const char* help )const
+      {
+         write_header( out, name, "histogram", help );
+         uint64_t cumulative = 0;
+         for( size_t i = 0; i < _bounds.size(); ++i )
+         {
+            cumulative += _bucket_counts[i];
+            out << name << "_bucket{le=\"" << _bounds[i] << "\"} " << cumulative << '\n';
+         }
+         out << name << "_bucket{le=\"+Inf\"} " << _count << '\n'
+             << name << "_sum " << _sum << '\n'
+             << name << "_count " << _count << '\n';
+      }
+
+   private:
+      std::vector<double>   _bounds;
+      /// The last bucket counts the values above all bounds
+      std::vector<uint64_t> _bucket_counts;
+      uint64_t              _count = 0;
+      double                _sum = 0;
+};
+
+class metrics_plugin_impl
+{
+   public:
+      explicit metrics_plugin_impl( metrics_plugin& _plugin );
+
+      void on_block( const signed_block& b );
+      /// adds the duration of the block applied since the last call to the histogram
+      void observe_apply_duration();
+      void on_request( const fc::http::request& req, const fc::http::server::response& resp );
+
+      void render_chain( std::ostream& out );
+      void render_indexes( std::ostream& out );
+      void render_p2p( std::ostream& out );
+
+      graphene::chain::database& database()
+      {
+         return _self.database();
+      }
+
+      friend class graphene::metrics::metrics_plugin;
+
+   private:
+      metrics_plugin& _self;
+
+      fc::ip::endpoint _endpoint = fc::ip::endpoint::from_string( "127.0.0.1:9180" );
+      std::unique_ptr<fc::http::server> _server;
+
+      histogram _latency { latency_bucket_bounds };
+      histogram _apply_duration { apply_bucket_bounds };
+
+      /// the block processing counters when the apply duration was last observed
+      uint64_t _observed_blocks = 0;
+      uint64_t _observed_apply_time = 0;
+};
+
+metrics_plugin_impl::metrics_plugin_impl( metrics_plugin& _plugin ) :
+   _self( _plugin )
+{ }
+
+void metrics_plugin_impl::on_block( const signed_block& b )
+{
+   _latency.observe( to_seconds( fc::time_point::now() - b.timestamp ) );
+   // the counters include the previous block by now
+   observe_apply_duration();
+}
+
+void metrics_plugin_impl::observe_apply_duration()
+{
+   const auto& counters = database().get_block_processing_counters();
+   // the counters are updated for every block and observed at least once per block, only blocks applied
+   // before startup are skipped
+   if( counters.blocks == _observed_blocks + 1 )
+      _apply_duration.observe( to_seconds( fc::microseconds( counters.apply_time - _observed_apply_time ) ) );
+   _observed_blocks = counters.blocks;
+   _observed_apply_time = counters.apply_time;
+}
+
+void metrics_plugin_impl::on_request( const fc::http::request& req, const fc::http::server::response& resp )
+{
+   if( req.path.substr( 0, req.path.find( '?' ) ) != "/metrics" )
+   {
+      resp.set_status( fc::http::reply::NotFound );
+      resp.set_length( 0 );
+      return;
+   }
+   const std::string body = _self.render_metrics();
+   resp.set_status( fc::http::reply::OK );
+   resp.add_header( "Content-Type", "text/plain; version=0.0.4" );
+   resp.set_length( body.size() );
+   resp.write( body.c_str(), body.size() );
+}
+
+void metrics_plugin_impl::render_chain( std::ostream& out )
+{
+   const auto& db = database();
+
+   write_metric( out, "graphene_head_block_number", "gauge", "Number of the head block", db.head_block_num() );
+   write_metric( out, "graphene_head_block_age_seconds", "gauge", "Time since the timestamp of the head block",
+                 to_seconds( fc::time_point::now() - db.head_block_time() ) );
+   write_metric( out, "graphene_last_irreversible_block_number", "gauge", "Number of the last irreversible block",
+                 db.get_dynamic_global_properties().last_irreversible_block_num );
+
+   _latency.render( out, "graphene_block_latency_seconds",
+                    "Time from the block timestamp until the block was applied" );
+   // include the block applied since the last applied_block signal
+   observe_apply_duration();
+   _apply_duration.render( out, "graphene_block_apply_duration_seconds",
+                           "Time spent applying a block, including the handlers of plugins" );
+
+   const auto& counters = db.get_block_processing_counters();
+   write_metric( out, "graphene_blocks_applied_total", "counter", "Number of blocks applied", counters.blocks );
+   write_metric( out, "graphene_block_apply_seconds_total", "counter",
+                 "Time spent applying blocks, including the handlers of plugins",
+                 to_seconds( fc::microseconds( counters.apply_time ) ) );
+   write_metric( out, "graphene_block_applied_handlers_seconds_total", "counter",
+                 "Time spent in the applied_block handlers of plugins",
+                 to_seconds( fc::microseconds( counters.applied_block_handlers_time ) ) );
+   write_metric( out, "graphene_block_object_handlers_seconds_total", "counter",
+                 "Time spent in the new, changed and removed object handlers of plugins",
+                 to_seconds( fc::microseconds( counters.object_handlers_time ) ) );
+
+   write_metric( out, "graphene_pending_transactions", "gauge", "Number of pending transactions",
+                 db.get_pending_transaction_count() );
+   write_metric( out, "graphene_undo_stack_depth", "gauge", "Number of states in the undo database",
+                 db._undo_db.size() );
+}
+
+void metrics_plugin_impl::render_indexes( std::ostream& out )
+{
+   const auto& db = database();
+
+   write_header( out, "graphene_index_objects", "gauge", "Number of objects in the index" );
+   db.inspect_all_indexes( [&out]( const graphene::db::index& idx ) {
+      out << "graphene_index_objects{space=\"" << uint32_t( idx.object_space_id() )
+          << "\",type=\"" << uint32_t( idx.object_type_id() ) << "\"} " << idx.object_count() << '\n';
+   } );
+
+   write_header( out, "graphene_index_memory_estimate_bytes", "gauge",
+                 "Number of objects in the index times the object size, "
+                 "not including memory allocated by the objects and the index nodes" );
+   db.inspect_all_indexes( [&out]( const graphene::db::index& idx ) {
+      out << "graphene_index_memory_estimate_bytes{space=\"" << uint32_t( idx.object_space_id() )
+          << "\",type=\"" << uint32_t( idx.object_type_id() ) << "\"} "
+          << idx.object_count() * idx.object_size() << '\n';
+   } );
+}
+
+void metrics_plugin_impl::render_p2p( std::ostream& out )
+{
+   const auto node = _self.p2p_node();
+   if( !node )
+      return;
+
+   const std::vector<graphene::net::peer_status> peers = node->get_connected_peers();
+   write_metric( out, "graphene_p2p_connected_peers", "gauge", "Number of connected peers", peers.size() );
+
+   struct peer_metric
+   {
+      const char* name;
+      const char* type;
+      const char* help;
+      const char* field;
+   };
+   static const peer_metric peer_metrics[] = {
+      { "graphene_p2p_peer_sent_bytes_total",     "counter", "Bytes sent to the peer",                  "bytessent" },
+      { "graphene_p2p_peer_received_bytes_total", "counter", "Bytes received from the peer",            "bytesrecv" },
+      { "graphene_p2p_peer_queued_messages",      "gauge",   "Messages waiting to be sent to the peer", "queued_messages" },
+      { "graphene_p2p_peer_queued_bytes",         "gauge",   "Bytes waiting to be sent to the peer",    "queued_bytes" }
+   };
+   for( const auto& metric : peer_metrics )
+   {
+      write_header( out, metric.name, metric.type, metric.help );
+      for( const auto& peer : peers )
+      {
+         auto itr = peer.info.find( metric.field );
+         if( itr != peer.info.end() )
+            out << metric.name << "{peer=\"" << std::string( peer.host ) << "\"} " << itr->value().as_uint64() << '\n';
+      }
+   }
+
+   // Calls from the p2p node into the blockchain, e.g. handle_block and handle_transaction
+   const fc::variant_object statistics = node->get_call_statistics();
+   write_header( out, "graphene_p2p_delegate_call_mean_seconds", "gauge",
+                 "Mean execution time of the most recent calls from the p2p node into the blockchain" );
+   for( const auto& entry : statistics )
+   {
+      if( !entry.value().is_object() )
+         continue;
+      const auto& method = entry.value().get_object();
+      auto itr = method.find( "mean" );
+      if( itr != method.end() )
+         out << "graphene_p2p_delegate_call_mean_seconds{method=\"" << entry.key() << "\"} "
+             << itr->value().as_double() / 1000000 << '\n';
+   }
+}
+
+} // end namespace detail
+
+metrics_plugin::metrics_plugin(graphene::app::application& app) :
+   plugin(app),
+   my( std::make_unique<detail::metrics_plugin_impl>(*this) )
+{
+   // Nothing else to do
+}
+
+metrics_plugin::~metrics_plugin() = default;
+
+std::string metrics_plugin::plugin_name()const
+{
+   return "metrics";
+}
+std::string metrics_plugin::plugin_description()const
+{
+   return "Serves node metrics in the Prometheus text format over HTTP.";
+}
+
+void metrics_plugin::plugin_set_program_options(
+   boost::program_options::options_description& cli,
+   boost::program_options::options_description& cfg
+   )
+{
+   cli.add_options()
+         ("metrics-endpoint", boost::program_options::value<std::string>(),
+               "Local endpoint to serve metrics on, at path /metrics(127.0.0.1:9180)")
+         ;
+   cfg.add(cli);
+}
+
+void metrics_plugin::plugin_initialize(const boost::program_options::variables_map& options)
+{ try {
+   if( options.count("metrics-endpoint") > 0 )
+      my->_endpoint = fc::ip::endpoint::from_string( options["metrics-endpoint"].as<std::string>() );
+} FC_LOG_AND_RETHROW() }
+
+void metrics_plugin::plugin_startup()
+{
+   // Connect here rather than in plugin_initialize, so that replayed blocks are not counted as late
+   const auto& counters = database().get_block_processing_counters();
+   my->_observed_blocks = counters.blocks;
+   my->_observed_apply_time = counters.apply_time;
+   database().applied_block.connect( [this]( const signed_block& b ) {
+      my->on_block( b );
+   } );
+
+   my->_server = std::make_unique<fc::http::server>();
+   my->_server->on_request( [this]( const fc::http::request& req, const fc::http::server::response& resp ) {
+      my->on_request( req, resp );
+   } );
+   my->_server->listen( my->_endpoint );
+   ilog( "metrics: serving on http://${e}/metrics", ("e", std::string( my->_endpoint )) );
+}
+
+void metrics_plugin::plugin_shutdown()
+{
+   my->_server.reset();
+}
+
+std::string metrics_plugin::render_metrics()const
+{
+   std::ostringstream out;
+   my->render_chain( out );
+   my->render_indexes( out );
+   my->render_p2p( out );
+   return out.str();
+}
+
+} }
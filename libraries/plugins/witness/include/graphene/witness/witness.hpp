@@ -28,6 +28,8 @@
 
 #include <fc/thread/future.hpp>
 
+#include <deque>
+
 namespace graphene { namespace witness_plugin {
 
 namespace block_production_condition
@@ -47,6 +49,19 @@ namespace block_production_condition
    };
 }
 
+/**
+ * Timing of a block produced by this node, durations are in microseconds
+ */
+struct block_production_timing
+{
+   uint32_t           block_num = 0;
+   fc::time_point_sec timestamp;          ///< slot time of the block
+   int64_t            wakeup_delay = 0;   ///< time from the scheduled wakeup until the production loop ran
+   int64_t            slot_offset = 0;    ///< time from the slot time until generation started, negative if early
+   int64_t            generate_time = 0;  ///< time to generate, apply, sign and push the block
+   int64_t            broadcast_time = 0; ///< time from the end of generation until the block was sent to peers
+};
+
 class witness_plugin : public graphene::app::plugin {
 public:
    using graphene::app::plugin::plugin;
@@ -69,6 +84,17 @@ public:
    inline const fc::flat_map< chain::witness_id_type, fc::optional<chain::public_key_type> >& get_witness_key_cache()
    { return _witness_key_cache; }
 
+   /// Largest accepted production-lead-time, maybe_produce_block() must still round the wakeup to the slot
+   static constexpr uint32_t max_production_lead_time_ms = 400;
+
+   /// Time to start producing for the first slot that is at least 50ms away, @p lead_time before the slot time
+   static fc::time_point next_production_wakeup( const chain::database& db, const fc::time_point& now,
+                                                 const fc::microseconds& lead_time );
+
+   /// Timing of the most recent blocks produced by this node, oldest first
+   const std::deque<block_production_timing>& get_block_production_timings()const
+   { return _production_timings; }
+
 private:
    void cleanup() { stop_block_production(); }
 
@@ -76,6 +102,7 @@ private:
    block_production_condition::block_production_condition_enum block_production_loop();
    block_production_condition::block_production_condition_enum maybe_produce_block( fc::limited_mutable_variant_object& capture );
    void add_private_key(const std::string& key_id_to_wif_pair_string);
+   void record_broadcast_time( uint32_t block_num, const fc::microseconds& broadcast_time );
 
    /// Fetch signing keys of all witnesses in the cache from object database and update the cache accordingly
    void refresh_witness_key_cache();
@@ -85,14 +112,22 @@ private:
    bool _shutting_down = false;
    uint32_t _required_witness_participation = 33 * GRAPHENE_1_PERCENT;
    uint32_t _production_skip_flags = graphene::chain::database::skip_nothing;
+   fc::microseconds _production_lead_time;
+   fc::time_point _next_wakeup;
 
    std::map<chain::public_key_type, fc::ecc::private_key, chain::pubkey_comparator> _private_keys;
    std::set<chain::witness_id_type> _witnesses;
    fc::future<void> _block_production_task;
 
+   static constexpr size_t max_production_timings = 100;
+   std::deque<block_production_timing> _production_timings;
+
    /// For tracking signing keys of specified witnesses, only update when applied a block
    fc::flat_map< chain::witness_id_type, fc::optional<chain::public_key_type> > _witness_key_cache;
 
 };
 
 } } //graphene::witness_plugin
+
+FC_REFLECT( graphene::witness_plugin::block_production_timing,
+            (block_num)(timestamp)(wakeup_delay)(slot_offset)(generate_time)(broadcast_time) )
@@ -70,6 +70,9 @@ void witness_plugin::plugin_set_program_options(
                "Enable block production, even if the chain is stale.")
          ("required-participation", bpo::value<uint32_t>()->default_value(33),
                "Percent of witnesses (0-100) that must be participating in order to produce blocks")
+         ("production-lead-time", bpo::value<uint32_t>()->default_value(0),
+               ("Milliseconds (0-" + std::to_string(max_production_lead_time_ms)
+                + ") before the slot time to start producing a block").c_str())
          ("witness-id,w", bpo::value<vector<string>>()->composing()->multitoken(),
                ("ID of witness controlled by this node (e.g. " + witness_id_example +
                ", quotes are required, may specify multiple times)").c_str())
@@ -164,6 +167,15 @@ void witness_plugin::plugin_initialize(const boost::program_options::variables_m
        else if(required_participation > 90)
            wlog("witness plugin: Warning - High required participation of ${rp}% found", ("rp", required_participation));
    }
+   if( options.count("production-lead-time") > 0 )
+   {
+      auto lead_time = options["production-lead-time"].as<uint32_t>();
+      // maybe_produce_block() rounds to the nearest second, so starting 500ms early or more would miss the slot,
+      // keep a margin for the wakeup jitter
+      FC_ASSERT( lead_time <= max_production_lead_time_ms,
+                 "production-lead-time can not be greater than ${max}", ("max", max_production_lead_time_ms) );
+      _production_lead_time = fc::milliseconds( lead_time );
+   }
    ilog("witness plugin:  plugin_initialize() end");
 } FC_LOG_AND_RETHROW() }
 
@@ -226,17 +238,19 @@ void witness_plugin::schedule_production_loop()
 {
    if (_shutting_down) return;
 
-   //Schedule for the next second's tick regardless of chain state
-   // If we would wait less than 50ms, wait for the whole second.
-   fc::time_point now = fc::time_point::now();
-   int64_t time_to_next_second = 1000000 - (now.time_since_epoch().count() % 1000000);
-   if( time_to_next_second < 50000 )      // we must sleep for at least 50ms
-       time_to_next_second += 1000000;
-
-   fc::time_point next_wakeup( now + fc::microseconds( time_to_next_second ) );
+   _next_wakeup = next_production_wakeup( database(), fc::time_point::now(), _production_lead_time );
 
    _block_production_task = fc::schedule([this]{block_production_loop();},
-                                         next_wakeup, "Witness Block Production");
+                                         _next_wakeup, "Witness Block Production");
+}
+
+fc::time_point witness_plugin::next_production_wakeup( const chain::database& db, const fc::time_point& now,
+                                                      const fc::microseconds& lead_time )
+{
+   // Schedule for the next slot regardless of chain state, minus the lead time.
+   // If we would wait less than 50ms, wait for the slot after that.
+   uint32_t next_slot = db.get_slot_at_time( now + lead_time + fc::milliseconds( 50 ) ) + 1;
+   return fc::time_point( db.get_slot_time( next_slot ) ) - lead_time;
 }
 
 block_production_condition::block_production_condition_enum witness_plugin::block_production_loop()
@@ -269,7 +283,7 @@ block_production_condition::block_production_condition_enum witness_plugin::bloc
    switch( result )
    {
       case block_production_condition::produced:
-         ilog("Generated block #${n} with ${x} transaction(s) and timestamp ${t} at time ${c}", (capture));
+         ilog("Generated block #${n} with ${x} transaction(s) and timestamp ${t} at time ${c} in ${g}ms", (capture));
          break;
       case block_production_condition::not_synced:
          ilog("Not producing block because production is disabled until we receive a recent block "
@@ -375,14 +389,44 @@ block_production_condition::block_production_condition_enum witness_plugin::mayb
    if( p2p_node() == nullptr )
       return block_production_condition::no_network;
 
+   fc::time_point generate_start = fc::time_point::now();
    auto block = db.generate_block(
       scheduled_time,
       scheduled_witness,
       private_key_itr->second,
       _production_skip_flags
       );
-   capture("n", block.block_num())("t", block.timestamp)("c", now)("x", block.transactions.size());
-   fc::async( [this,block](){ p2p_node()->broadcast(net::block_message(block)); } );
+   fc::time_point generate_end = fc::time_point::now();
+
+   block_production_timing timing;
+   timing.block_num = block.block_num();
+   timing.timestamp = block.timestamp;
+   timing.wakeup_delay = ( now_fine - _next_wakeup ).count();
+   timing.slot_offset = ( generate_start - fc::time_point( scheduled_time ) ).count();
+   timing.generate_time = ( generate_end - generate_start ).count();
+   if( _production_timings.size() >= max_production_timings )
+      _production_timings.pop_front();
+   _production_timings.push_back( timing );
+
+   capture("n", block.block_num())("t", block.timestamp)("c", now)("x", block.transactions.size())
+          ("g", timing.generate_time / 1000);
+   fc::async( [this,block,generate_end](){
+      p2p_node()->broadcast(net::block_message::from_block(block));
+      record_broadcast_time( block.block_num(), fc::time_point::now() - generate_end );
+   } );
 
    return block_production_condition::produced;
 }
+
+void witness_plugin::record_broadcast_time( uint32_t block_num, const fc::microseconds& broadcast_time )
+{
+   // usually the last one, unless the record has already been dropped
+   for( auto itr = _production_timings.rbegin(); itr != _production_timings.rend(); ++itr )
+   {
+      if( itr->block_num == block_num )
+      {
+         itr->broadcast_time = broadcast_time.count();
+         return;
+      }
+   }
+}
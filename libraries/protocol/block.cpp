@@ -98,6 +98,31 @@ namespace graphene { namespace protocol {
       }
       return _calculated_merkle_root;
    }
+
+   uint64_t signed_block::get_packed_size()const
+   {
+      uint64_t size = fc::raw::pack_size( static_cast<const signed_block_header&>( *this ) )
+                    + fc::raw::pack_size( fc::unsigned_int( static_cast<uint32_t>( transactions.size() ) ) );
+      // a processed_transaction is packed as the signed_transaction followed by the operation results
+      for( const auto& trx : transactions )
+         size += trx.get_packed_signed_transaction()->size() + fc::raw::pack_size( trx.operation_results );
+      return size;
+   }
+
+   vector<char> signed_block::get_packed()const
+   {
+      vector<char> result( get_packed_size() );
+      fc::datastream<char*> ds( result.data(), result.size() );
+      fc::raw::pack( ds, static_cast<const signed_block_header&>( *this ) );
+      fc::raw::pack( ds, fc::unsigned_int( static_cast<uint32_t>( transactions.size() ) ) );
+      for( const auto& trx : transactions )
+      {
+         const auto& packed_trx = trx.get_packed_signed_transaction();
+         ds.write( packed_trx->data(), packed_trx->size() );
+         fc::raw::pack( ds, trx.operation_results );
+      }
+      return result;
+   }
 } }
 
 GRAPHENE_IMPLEMENT_EXTERNAL_SERIALIZATION( graphene::protocol::block_header)
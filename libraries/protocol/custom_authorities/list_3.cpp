@@ -35,7 +35,9 @@ result_type get_restriction_pred_list_3(size_t idx, vector<restriction> rs) {
       result_type to_return = [p=restrictions_to_predicate<Op>(std::move(rs), true)] (const operation& op) {
          FC_ASSERT(op.which() == operation::tag<Op>::value,
                    "Supplied operation is incorrect type for restriction predicate");
-         return p(op.get<Op>());
+         // Reverse the order of the rejection path, because the order the path is created in, from the top of
+         // the call stack to the bottom, is counterintuitive
+         return p(op.get<Op>()).reverse_path();
       };
       return to_return;
    });
@@ -27,10 +27,16 @@
 #include "restriction_predicate.hxx"
 #include "sliced_lists.hxx"
 
+#include <fc/io/raw.hpp>
+
+#include <map>
+#include <mutex>
+
 namespace graphene { namespace protocol {
 
 restriction_predicate_function get_restriction_predicate(vector<restriction> rs, operation::tag_type op_type) {
-   auto f = typelist::runtime::dispatch(operation::list(), op_type, [&rs](auto t) -> restriction_predicate_function {
+   // The functions of the sliced lists reverse the order of the rejection path if they return an error
+   return typelist::runtime::dispatch(operation::list(), op_type, [&rs](auto t) -> restriction_predicate_function {
       using Op = typename decltype(t)::type;
       if (typelist::contains<operation_list_1::list, Op>())
          return get_restriction_pred_list_1(typelist::index_of<operation_list_1::list, Op>(), std::move(rs));
@@ -63,10 +69,37 @@ restriction_predicate_function get_restriction_predicate(vector<restriction> rs,
                          "LOGIC ERROR: Operation type not handled by custom authorities implementation. "
                          "Please report this error.");
    });
+}
 
-   // Wrap function in a layer that, if the function returns an error, reverses the order of the rejection path. This
-   // is because the order the path is created in, from the top of the call stack to the bottom, is counterintuitive.
-   return [f=std::move(f)](const operation& op) { return f(op).reverse_path(); };
+std::shared_ptr<const restriction_predicate_function> get_shared_restriction_predicate(const vector<restriction>& rs,
+                                                                                       operation::tag_type op_type) {
+   using key_type = std::pair<operation::tag_type, vector<char>>;
+   static std::mutex cache_mutex;
+   static std::map<key_type, std::weak_ptr<const restriction_predicate_function>> cache;
+   // Size of the cache after the last sweep of expired entries
+   static size_t size_after_sweep = 0;
+   constexpr size_t min_size_to_sweep = 64;
+
+   key_type key(op_type, fc::raw::pack(rs));
+   std::lock_guard<std::mutex> guard(cache_mutex);
+   auto itr = cache.find(key);
+   if (itr != cache.end()) {
+      auto shared = itr->second.lock();
+      if (shared)
+         return shared;
+   }
+
+   // Building the predicate throws if the restrictions are invalid, in which case nothing is cached
+   auto predicate = std::make_shared<const restriction_predicate_function>(get_restriction_predicate(rs, op_type));
+   // Drop the predicates which are no longer used by anyone once the cache has doubled since the last sweep,
+   // so that the cost of sweeping is spread over the insertions
+   if (cache.size() >= std::max(2 * size_after_sweep, min_size_to_sweep)) {
+      for (auto expired = cache.begin(); expired != cache.end(); )
+         expired = expired->second.expired() ? cache.erase(expired) : std::next(expired);
+      size_after_sweep = cache.size();
+   }
+   cache[std::move(key)] = predicate;
+   return predicate;
 }
 
 predicate_result& predicate_result::reverse_path() {
@@ -28,18 +28,70 @@
 
 namespace graphene { namespace protocol {
 
+   struct fee_table_builder
+   {
+      using result_type = void;
+
+      const fee_schedule& param;
+      const fee_parameters*& result;
+      fee_table_builder( const fee_schedule& p, const fee_parameters*& r ):param(p),result(r)
+      { /* Nothing else to do */ }
+
+      template<typename OpType>
+      result_type operator()( const OpType& )const
+      {
+         using params_type = typename OpType::fee_parameters_type;
+         auto itr = param.parameters.find( params_type() );
+         if( itr == param.parameters.end() )
+            return;
+         // some operations do not use their stored parameters as they are, leave them to the search
+         if( &param.get<OpType>() == &itr->template get<params_type>() )
+            result = &*itr;
+      }
+   };
+
+   const fee_table& fee_schedule::get_fee_table( bool rebuild )const
+   {
+      const fee_parameters* first = parameters.empty() ? nullptr : &*parameters.begin();
+      const fee_table* table = _fee_tables.current.load( std::memory_order_acquire );
+      if( table != nullptr && !rebuild && table->first == first && table->size == parameters.size() )
+         return *table;
+
+      auto result = std::make_unique<fee_table>();
+      const auto count = operation::count();
+      result->parameters.resize( count, nullptr );
+      for( size_t i = 0; i < count; ++i )
+      {
+         operation op;
+         op.set_which( i );
+         op.visit( fee_table_builder( *this, result->parameters[i] ) );
+      }
+      result->first = first;
+      result->size = parameters.size();
+
+      table = result.get();
+      std::lock_guard<std::mutex> guard( _fee_tables.mutex );
+      _fee_tables.tables.push_back( std::move( result ) );
+      _fee_tables.current.store( table, std::memory_order_release );
+      return *table;
+   }
+
    struct calc_fee_visitor
    {
       using result_type = uint64_t;
 
       const fee_schedule& param;
+      const fee_parameters* stored;
       const operation::tag_type current_op;
-      calc_fee_visitor( const fee_schedule& p, const operation& op ):param(p),current_op(op.which())
+      calc_fee_visitor( const fee_schedule& p, const fee_parameters* s, const operation& op )
+      :param(p),stored(s),current_op(op.which())
       { /* Nothing else to do */ }
 
       template<typename OpType>
       result_type operator()( const OpType& op )const
       {
+         if( stored != nullptr )
+            return op.calculate_fee( stored->get<typename OpType::fee_parameters_type>() ).value;
          try {
             return op.calculate_fee( param.get<OpType>() ).value;
          } catch (fc::assert_exception& e) {
@@ -78,7 +130,14 @@ namespace graphene { namespace protocol {
 
    asset fee_schedule::calculate_fee( const operation& op )const
    {
-      uint64_t required_fee = op.visit( calc_fee_visitor( *this, op ) );
+      // the table only tells where the parameters are stored, a value written there in place is used at once
+      const fee_parameters* stored = get_fee_table().parameters[op.which()];
+      if( stored != nullptr && stored->which() != op.which() )
+      {
+         // the elements were replaced without moving the storage
+         stored = get_fee_table( true ).parameters[op.which()];
+      }
+      uint64_t required_fee = op.visit( calc_fee_visitor( *this, stored, op ) );
       if( scale != GRAPHENE_100_PERCENT )
       {
          auto scaled = fc::uint128_t(required_fee) * scale;
@@ -60,6 +60,13 @@ namespace graphene { namespace protocol {
    {
    public:
       const checksum_type& calculate_merkle_root()const;
+      /**
+       * @return the same bytes as fc::raw::pack( *this ), assembled from the packed transactions cached in
+       *         @ref precomputable_transaction so that only the header is packed again
+       */
+      vector<char> get_packed()const;
+      /// @return the same as fc::raw::pack_size( *this ), calculated from the packed transactions
+      uint64_t get_packed_size()const;
       vector<processed_transaction> transactions;
    protected:
       mutable checksum_type   _calculated_merkle_root;
@@ -24,6 +24,9 @@
 #pragma once
 #include <graphene/protocol/operations.hpp>
 
+#include <atomic>
+#include <mutex>
+
 namespace graphene { namespace protocol {
 
    template<typename T> struct transform_to_fee_parameters;
@@ -167,6 +170,41 @@ namespace graphene { namespace protocol {
          return htlc_extend_operation_fee_dummy;
       }
    };
+   /**
+    *  @brief where the parameters of every operation type are stored in a fee schedule, so that calculating a fee
+    *  does not need a search
+    *
+    *  The table refers to the elements of fee_schedule::parameters instead of copying them, so that values written
+    *  in place are seen at once. It is only used while the storage it was built from is unchanged, and an entry
+    *  is only used while it still holds the parameters of its operation.
+    */
+   struct fee_table
+   {
+      /// indexed by operation tag, nullptr if the parameters are missing or not used as they are stored
+      vector<const fee_parameters*> parameters;
+      /// the storage of fee_schedule::parameters when the table was built
+      const fee_parameters*         first = nullptr;
+      size_t                        size = 0;
+   };
+
+   /**
+    *  @brief the fee tables built for a fee schedule
+    *
+    *  The current table is read with a plain atomic pointer load. Replaced tables are kept until the schedule is
+    *  destroyed because another thread may still be using them. A copy starts empty, since a table refers to the
+    *  storage it was built from.
+    */
+   struct fee_table_cache
+   {
+      fee_table_cache() = default;
+      fee_table_cache( const fee_table_cache& ) { /* Nothing to copy */ }
+      fee_table_cache& operator=( const fee_table_cache& ) { return *this; }
+
+      std::atomic<const fee_table*>            current { nullptr };
+      std::mutex                               mutex;
+      vector< std::unique_ptr<const fee_table> > tables;
+   };
+
    /**
     *  @brief contains all of the parameters necessary to calculate the fee for any operation
     */
@@ -221,6 +259,11 @@ namespace graphene { namespace protocol {
       uint32_t                      scale = GRAPHENE_100_PERCENT; ///< fee * scale / GRAPHENE_100_PERCENT
    private:
       static fee_schedule get_default_impl();
+
+      /// Returns a table that matches the current storage of @ref parameters, rebuilding it if needed
+      const fee_table& get_fee_table( bool rebuild = false )const;
+
+      mutable fee_table_cache _fee_tables;
    };
 
    using fee_schedule_type = fee_schedule;
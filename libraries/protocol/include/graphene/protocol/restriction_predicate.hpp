@@ -27,6 +27,7 @@
 #include <graphene/protocol/operations.hpp>
 
 #include <functional>
+#include <memory>
 
 namespace graphene { namespace protocol {
 
@@ -69,6 +70,16 @@ using restriction_predicate_function = std::function<predicate_result(const oper
  */
 restriction_predicate_function get_restriction_predicate(vector<restriction> rs, operation::tag_type op_type);
 
+/**
+ * @brief get_shared_restriction_predicate Get a predicate function for the supplied restriction, sharing it with all
+ * callers which supply identical restrictions for the same operation type
+ *
+ * The predicate is built by @ref get_restriction_predicate at most once for as long as it remains in use, so many
+ * custom authorities with the same restrictions share a single instance of it.
+ */
+std::shared_ptr<const restriction_predicate_function> get_shared_restriction_predicate(const vector<restriction>& rs,
+                                                                                       operation::tag_type op_type);
+
 } } // namespace graphene::protocol
 
 FC_REFLECT_ENUM(graphene::protocol::predicate_result::rejection_reason,
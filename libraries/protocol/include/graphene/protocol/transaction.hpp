@@ -222,6 +222,9 @@ namespace graphene { namespace protocol {
       /** Removes all signatures */
       void clear_signatures() { signatures.clear(); }
    protected:
+      /** Extracts the public keys from the signatures of the given signature digest and stores them in @ref _signees */
+      const flat_set<public_key_type>& recover_signature_keys( const digest_type& signed_digest )const;
+
       /** Public keys extracted from signatures */
       mutable flat_set<public_key_type> _signees;
    };
@@ -241,9 +244,18 @@ namespace graphene { namespace protocol {
       virtual void                             validate()const override;
       virtual const flat_set<public_key_type>& get_signature_keys( const chain_id_type& chain_id )const override;
       virtual uint64_t                         get_packed_size()const override;
+
+      /**
+       * @return this transaction packed with fc::raw as a @ref signed_transaction, i.e. as it is sent over the
+       *         network and stored in blocks. It is packed once and shared by the copies of this transaction;
+       *         the ID, the signature digest and the packed size are calculated from it.
+       */
+      const std::shared_ptr<const vector<char>>& get_packed_signed_transaction()const;
    protected:
       mutable bool _validated = false;
+      /// Size of the packed @ref transaction, which is the beginning of @ref _packed_signed_transaction
       mutable uint64_t _packed_size = 0;
+      mutable std::shared_ptr<const vector<char>> _packed_signed_transaction;
    };
 
    /**
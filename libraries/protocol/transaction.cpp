@@ -349,18 +349,22 @@ void verify_authority( const vector<operation>& ops, const flat_set<public_key_t
 
 const flat_set<public_key_type>& signed_transaction::get_signature_keys( const chain_id_type& chain_id )const
 { try {
-   auto d = sig_digest( chain_id );
+   return recover_signature_keys( sig_digest( chain_id ) );
+} FC_CAPTURE_AND_RETHROW() }
+
+const flat_set<public_key_type>& signed_transaction::recover_signature_keys( const digest_type& signed_digest )const
+{
    flat_set<public_key_type> result;
    for( const auto&  sig : signatures )
    {
       GRAPHENE_ASSERT(
-         result.insert( fc::ecc::public_key(sig,d) ).second,
+         result.insert( fc::ecc::public_key(sig,signed_digest) ).second,
             tx_duplicate_sig,
             "Duplicate Signature detected" );
    }
    _signees = std::move( result );
    return _signees;
-} FC_CAPTURE_AND_RETHROW() }
+}
 
 
 set<public_key_type> signed_transaction::get_required_signatures( const chain_id_type& chain_id,
@@ -431,10 +435,26 @@ set<public_key_type> signed_transaction::minimize_required_signatures(
    return set<public_key_type>( result.begin(), result.end() );
 }
 
+const std::shared_ptr<const vector<char>>& precomputable_transaction::get_packed_signed_transaction()const
+{
+   if( !_packed_signed_transaction )
+   {
+      auto packed = std::make_shared<vector<char>>( fc::raw::pack( static_cast<const signed_transaction&>( *this ) ) );
+      // a signed_transaction is packed as the transaction followed by the signatures
+      _packed_size = packed->size() - fc::raw::pack_size( signatures );
+      _packed_signed_transaction = std::move( packed );
+   }
+   return _packed_signed_transaction;
+}
+
 const transaction_id_type& precomputable_transaction::id()const
 {
    if( 0 == _tx_id_buffer._hash[0].value() )
-      transaction::id();
+   {
+      const auto& packed = get_packed_signed_transaction();
+      const auto h = digest_type::hash( packed->data(), static_cast<uint32_t>( _packed_size ) );
+      memcpy(_tx_id_buffer._hash, h._hash, std::min(sizeof(_tx_id_buffer), sizeof(h)));
+   }
    return _tx_id_buffer;
 }
 
@@ -448,7 +468,7 @@ void precomputable_transaction::validate() const
 uint64_t precomputable_transaction::get_packed_size()const
 {
    if( _packed_size == 0 )
-      _packed_size = transaction::get_packed_size();
+      get_packed_signed_transaction();
    return _packed_size;
 }
 
@@ -457,7 +477,13 @@ const flat_set<public_key_type>& precomputable_transaction::get_signature_keys(
    // Strictly we should check whether the given chain ID is same as the one used to initialize the `signees` field.
    // However, we don't pass in another chain ID so far, for better performance, we skip the check.
    if( _signees.empty() )
-      signed_transaction::get_signature_keys( chain_id );
+   { try {
+      const auto& packed = get_packed_signed_transaction();
+      digest_type::encoder enc;
+      fc::raw::pack( enc, chain_id );
+      enc.write( packed->data(), static_cast<uint32_t>( _packed_size ) );
+      recover_signature_keys( enc.result() );
+   } FC_CAPTURE_AND_RETHROW() }
    return _signees;
 }
 
@@ -35,6 +35,8 @@
 #include <graphene/grouped_orders/grouped_orders_plugin.hpp>
 #include <graphene/api_helper_indexes/api_helper_indexes.hpp>
 #include <graphene/custom_operations/custom_operations_plugin.hpp>
+#include <graphene/delta_stream/delta_stream_plugin.hpp>
+#include <graphene/metrics/metrics_plugin.hpp>
 
 #include <fc/thread/thread.hpp>
 #include <fc/interprocess/signals.hpp>
@@ -120,6 +122,8 @@ int main(int argc, char** argv) {
       node->register_plugin<graphene::grouped_orders::grouped_orders_plugin>();
       node->register_plugin<graphene::api_helper_indexes::api_helper_indexes>();
       node->register_plugin<graphene::custom_operations::custom_operations_plugin>();
+      node->register_plugin<graphene::delta_stream::delta_stream_plugin>();
+      node->register_plugin<graphene::metrics::metrics_plugin>();
 
       // add plugin options to config
       try
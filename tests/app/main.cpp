@@ -27,12 +27,15 @@
 
 #include <graphene/chain/balance_object.hpp>
 
+#include <graphene/utilities/key_conversion.hpp>
 #include <graphene/utilities/tempdir.hpp>
 
 #include <graphene/account_history/account_history_plugin.hpp>
 #include <graphene/market_history/market_history_plugin.hpp>
 #include <graphene/witness/witness.hpp>
 #include <graphene/grouped_orders/grouped_orders_plugin.hpp>
+#include <graphene/debug_witness/debug_api.hpp>
+#include <graphene/delayed_node/delayed_node_plugin.hpp>
 
 #include <fc/thread/thread.hpp>
 #include <fc/log/appender.hpp>
@@ -391,6 +394,156 @@ BOOST_AUTO_TEST_CASE( two_node_network )
    }
 }
 
+/////////////
+/// @brief sync a delayed node from a local full node and check that it follows the last irreversible block
+/////////////
+BOOST_AUTO_TEST_CASE( delayed_node_follows_lib )
+{
+   using namespace graphene::chain;
+   using namespace graphene::app;
+   try {
+      fc::temp_directory app_dir( graphene::utilities::temp_directory_path() );
+      auto genesis_file = create_genesis_file(app_dir);
+      fc::ecc::private_key committee_key = fc::ecc::private_key::regenerate(fc::sha256::hash(string("nathan")));
+
+      BOOST_TEST_MESSAGE( "Creating and starting the full node" );
+      auto rpc_endpoint_str = string("127.0.0.1:") + std::to_string(fc::network::get_available_port());
+      graphene::app::application app1;
+      auto sharable_cfg = std::make_shared<boost::program_options::variables_map>();
+      auto& cfg = *sharable_cfg;
+      fc::set_option( cfg, "rpc-endpoint", rpc_endpoint_str );
+      fc::set_option( cfg, "genesis-json", genesis_file );
+      fc::set_option( cfg, "seed-nodes", string("[]") );
+      app1.initialize(app_dir.path(), sharable_cfg);
+      // let the delayed node use the pipelined block_api path
+      api_access_info wild_access;
+      wild_access.password_hash_b64 = "*";
+      wild_access.password_salt_b64 = "*";
+      wild_access.allowed_apis = { "database_api", "block_api" };
+      app1.set_api_access_info( "*", std::move(wild_access) );
+      app1.startup();
+
+      std::shared_ptr<chain::database> db1 = app1.chain_database();
+      auto generate_block = [db1,&committee_key]() {
+         db1->generate_block( db1->get_slot_time(1), db1->get_scheduled_witness(1), committee_key,
+                              database::skip_nothing );
+      };
+
+      // several batches of blocks for the delayed node to fetch
+      for( uint32_t i = 0; i < 450; ++i )
+         generate_block();
+      const uint32_t first_lib = db1->get_dynamic_global_properties().last_irreversible_block_num;
+      BOOST_REQUIRE_GT( first_lib, 400u );
+
+      BOOST_TEST_MESSAGE( "Creating and starting the delayed node" );
+      fc::temp_directory app2_dir( graphene::utilities::temp_directory_path() );
+      graphene::app::application app2;
+      app2.register_plugin< graphene::delayed_node::delayed_node_plugin >( true );
+      auto sharable_cfg2 = std::make_shared<boost::program_options::variables_map>();
+      auto& cfg2 = *sharable_cfg2;
+      fc::set_option( cfg2, "genesis-json", genesis_file );
+      fc::set_option( cfg2, "seed-nodes", string("[]") );
+      fc::set_option( cfg2, "trusted-node", rpc_endpoint_str );
+      app2.initialize(app2_dir.path(), sharable_cfg2);
+      app2.startup();
+
+      std::shared_ptr<chain::database> db2 = app2.chain_database();
+
+      // the delayed node only syncs when it is notified of a new block, keep producing until it has caught up
+      fc::wait_for( fc::seconds(30), [db2,first_lib,&generate_block] () {
+         generate_block();
+         return db2->head_block_num() >= first_lib;
+      });
+
+      BOOST_TEST_MESSAGE( "Checking that the delayed node stops at the last irreversible block" );
+      generate_block();
+      fc::wait_for( fc::seconds(15), [db1,db2] () {
+         return db2->head_block_num() == db1->get_dynamic_global_properties().last_irreversible_block_num;
+      });
+      BOOST_CHECK_LT( db2->head_block_num(), db1->head_block_num() );
+      BOOST_CHECK( db2->head_block_id() == db1->fetch_block_by_number( db2->head_block_num() )->id() );
+
+   } catch( fc::exception& e ) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+/////////////
+/// @brief produce blocks ahead of the slot time and check the timings reported by the debug API
+/////////////
+BOOST_AUTO_TEST_CASE( block_production_timings )
+{
+   using namespace graphene::chain;
+   using namespace graphene::app;
+   try {
+      fc::temp_directory app_dir( graphene::utilities::temp_directory_path() );
+      auto genesis_file = create_genesis_file(app_dir);
+
+      // all the initial witnesses use the nathan key
+      fc::ecc::private_key nathan_key = fc::ecc::private_key::regenerate(fc::sha256::hash(string("nathan")));
+      vector<string> witness_ids;
+      for( uint64_t i = 1; i <= GRAPHENE_DEFAULT_MIN_WITNESS_COUNT; ++i )
+         witness_ids.push_back( fc::json::to_string( witness_id_type(i) ) );
+      vector<string> private_keys { fc::json::to_string( std::make_pair( public_key_type( nathan_key.get_public_key() ),
+                                                             graphene::utilities::key_to_wif( nathan_key ) ) ) };
+
+      BOOST_TEST_MESSAGE( "Checking that a lead time too long to be rounded to the slot is rejected" );
+      {
+         fc::temp_directory bad_dir( graphene::utilities::temp_directory_path() );
+         graphene::app::application bad_app;
+         bad_app.register_plugin< graphene::witness_plugin::witness_plugin >( true );
+         auto bad_cfg = std::make_shared<boost::program_options::variables_map>();
+         fc::set_option( *bad_cfg, "genesis-json", genesis_file );
+         fc::set_option( *bad_cfg, "production-lead-time", uint32_t(500) );
+         BOOST_CHECK_THROW( bad_app.initialize( bad_dir.path(), bad_cfg ), fc::exception );
+      }
+
+      BOOST_TEST_MESSAGE( "Creating and starting a witness node" );
+      const uint32_t lead_time_ms = 200;
+      graphene::app::application app1;
+      app1.register_plugin< graphene::witness_plugin::witness_plugin >( true );
+      auto sharable_cfg = std::make_shared<boost::program_options::variables_map>();
+      auto& cfg = *sharable_cfg;
+      fc::set_option( cfg, "p2p-endpoint", string("127.0.0.1:") + std::to_string(fc::network::get_available_port()) );
+      fc::set_option( cfg, "genesis-json", genesis_file );
+      fc::set_option( cfg, "seed-nodes", string("[]") );
+      fc::set_option( cfg, "witness-id", witness_ids );
+      fc::set_option( cfg, "private-key", private_keys );
+      fc::set_option( cfg, "production-lead-time", lead_time_ms );
+      app1.initialize(app_dir.path(), sharable_cfg);
+      app1.startup();
+
+      std::shared_ptr<chain::database> db1 = app1.chain_database();
+      fc::wait_for( fc::seconds(30), [db1] () {
+         return db1->head_block_num() >= 2;
+      });
+
+      BOOST_TEST_MESSAGE( "Checking the block production timings" );
+      graphene::debug_witness::debug_api debug( app1 );
+      auto timings = debug.debug_get_block_production_timings()
+                        .as< vector<graphene::witness_plugin::block_production_timing> >( 2 );
+      BOOST_REQUIRE_GE( timings.size(), 2u );
+      for( const auto& timing : timings )
+      {
+         auto block = db1->fetch_block_by_number( timing.block_num );
+         BOOST_REQUIRE( block.valid() );
+         BOOST_CHECK( block->timestamp == timing.timestamp );
+         // the loop wakes up the lead time before the slot, generation may not start any earlier
+         BOOST_CHECK_GE( timing.wakeup_delay, 0 );
+         BOOST_CHECK_GE( timing.slot_offset, -int64_t(lead_time_ms) * 1000 );
+         BOOST_CHECK_LT( timing.slot_offset, fc::milliseconds(2500).count() );
+         BOOST_CHECK_GE( timing.generate_time, 0 );
+      }
+      // oldest first
+      BOOST_CHECK_LT( timings.front().block_num, timings.back().block_num );
+
+   } catch( fc::exception& e ) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
 /// a contrived example to test the breaking out of application_impl to a header file
 BOOST_AUTO_TEST_CASE(application_impl_breakout) {
 
@@ -31,6 +31,8 @@
 #include <graphene/api_helper_indexes/api_helper_indexes.hpp>
 #include <graphene/es_objects/es_objects.hpp>
 #include <graphene/custom_operations/custom_operations_plugin.hpp>
+#include <graphene/delta_stream/delta_stream_plugin.hpp>
+#include <graphene/metrics/metrics_plugin.hpp>
 
 #include <graphene/chain/balance_object.hpp>
 #include <graphene/chain/committee_member_object.hpp>
@@ -214,6 +216,10 @@ std::shared_ptr<boost::program_options::variables_map> database_fixture_base::in
    {
       fc::set_option( options, "api-limit-get-grouped-limit-orders", (uint64_t)250 );
    }
+   if(fixture.current_test_name =="grouped_limit_orders_subscriptions")
+   {
+      fc::set_option( options, "api-limit-grouped-orders-subscriptions", (uint64_t)2 );
+   }
    if(fixture.current_test_name =="api_limit_get_relative_account_history")
    {
       fc::set_option( options, "max-ops-per-account", (uint64_t)125 );
@@ -313,6 +319,8 @@ std::shared_ptr<boost::program_options::variables_map> database_fixture_base::in
       track_account.push_back(track);
       fc::set_option( options, "track-account", track_account );
       fc::set_option( options, "partial-operations", true );
+      // untracked operations leave holes in the ids, look them up through the hash index
+      fc::set_option( options, "operation-history-hash-index", true );
    }
    // account tracking 2 accounts
    if( !options.count("track-account") && fixture.current_test_name == "track_account2") {
@@ -352,7 +360,8 @@ std::shared_ptr<boost::program_options::variables_map> database_fixture_base::in
       fixture.app.register_plugin<graphene::account_history::account_history_plugin>(true);
    }
 
-   if(fixture.current_test_name == "elasticsearch_objects" || fixture.current_test_name == "elasticsearch_suite") {
+   if(fixture.current_test_name == "elasticsearch_objects" || fixture.current_test_name == "elasticsearch_suite" ||
+         fixture.current_test_name == "elasticsearch_objects_coalesce") {
       fixture.app.register_plugin<graphene::es_objects::es_objects_plugin>(true);
 
       fc::set_option( options, "es-objects-elasticsearch-url", GRAPHENE_TESTING_ES_URL );
@@ -368,6 +377,8 @@ std::shared_ptr<boost::program_options::variables_map> database_fixture_base::in
       fixture.es_obj_index_prefix = string("objects-") + fc::to_string(uint64_t(rand())) + "-";
       BOOST_TEST_MESSAGE( string("ES_OBJ index prefix is ") + fixture.es_obj_index_prefix );
       fc::set_option( options, "es-objects-index-prefix", fixture.es_obj_index_prefix );
+      if(fixture.current_test_name == "elasticsearch_objects_coalesce")
+         fc::set_option( options, "es-objects-coalesce-blocks", uint32_t(3) );
    }
 
    if( fixture.current_test_name == "asset_in_collateral"
@@ -385,6 +396,17 @@ std::shared_ptr<boost::program_options::variables_map> database_fixture_base::in
       fc::set_option( options, "custom-operations-start-block", uint32_t(1) );
    }
 
+   if(fixture.current_test_name == "delta_stream_test") {
+      fixture.app.register_plugin<graphene::delta_stream::delta_stream_plugin>(true);
+      fc::set_option( options, "delta-stream-dir", ( fixture.data_dir.path() / "delta_stream" ).generic_string() );
+      fc::set_option( options, "delta-stream-file-size", uint32_t(1) );
+   }
+
+   if(fixture.current_test_name == "metrics_render_test") {
+      fixture.app.register_plugin<graphene::metrics::metrics_plugin>(true);
+      fc::set_option( options, "metrics-endpoint", string("127.0.0.1:0") );
+   }
+
    fc::set_option( options, "bucket-size", string("[15]") );
 
    fixture.app.register_plugin<graphene::market_history::market_history_plugin>(true);
@@ -272,6 +272,84 @@ BOOST_AUTO_TEST_CASE(elasticsearch_objects) {
    }
 }
 
+BOOST_AUTO_TEST_CASE(elasticsearch_objects_coalesce) {
+   try {
+
+      CURL *curl; // curl handler
+      curl = curl_easy_init();
+      curl_easy_setopt(curl, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1_2);
+
+      graphene::utilities::ES es;
+      es.curl = curl;
+      es.elasticsearch_url = GRAPHENE_TESTING_ES_URL;
+      es.index_prefix = es_obj_index_prefix;
+
+      auto delete_objects = graphene::utilities::deleteAll(es);
+      BOOST_REQUIRE(delete_objects); // require successful deletion
+
+      // changes are collected for 3 blocks
+      const asset_id_type usd_id = create_bitasset("USD", account_id_type()).id;
+      generate_blocks(3);
+
+      es.endpoint = es.index_prefix + "*/data/_count";
+      es.query = "{ \"query\" : { \"bool\" : { \"must\" : [{\"match_all\": {}}] } } }";
+
+      string res;
+      variant j;
+      string total;
+
+      fc::wait_for( ES_WAIT_TIME,  [&]() {
+         res = graphene::utilities::simpleQuery(es);
+         j = fc::json::from_string(res);
+         total = j["count"].as_string();
+         return (total == "2");
+      });
+      BOOST_REQUIRE_EQUAL(total, "2");
+
+      es.endpoint = es.index_prefix + "asset/data/_search";
+      es.query = "{ \"version\" : true, \"query\" : { \"match_all\" : {} } }";
+      res = graphene::utilities::simpleQuery(es);
+      j = fc::json::from_string(res);
+      const uint32_t flush_block_num = j["hits"]["hits"][size_t(0)]["_source"]["block_number"].as_uint64();
+      const int64_t first_version = j["hits"]["hits"][size_t(0)]["_version"].as_int64();
+
+      // change the asset in each of the 3 blocks after a flush
+      while( db.head_block_num() % 3 != flush_block_num % 3 )
+         generate_block();
+      const uint32_t next_flush_block_num = db.head_block_num() + 3;
+      for( uint32_t i = 1; i <= 3; ++i )
+      {
+         asset_update_operation op;
+         op.issuer = account_id_type();
+         op.asset_to_update = usd_id;
+         op.new_options = usd_id(db).options;
+         op.new_options.description = fc::to_string( uint64_t(i) );
+         trx.operations.push_back( op );
+         set_expiration( db, trx );
+         PUSH_TX( db, trx, ~0 );
+         trx.clear();
+         generate_block();
+      }
+      BOOST_CHECK_EQUAL( db.head_block_num(), next_flush_block_num );
+
+      // only the latest state was sent, in a single update
+      string description;
+      fc::wait_for( ES_WAIT_TIME,  [&]() {
+         res = graphene::utilities::simpleQuery(es);
+         j = fc::json::from_string(res);
+         description = j["hits"]["hits"][size_t(0)]["_source"]["options"]["description"].as_string();
+         return (description == "3");
+      });
+      BOOST_CHECK_EQUAL( description, "3" );
+      BOOST_CHECK_EQUAL( j["hits"]["hits"][size_t(0)]["_source"]["block_number"].as_uint64(), next_flush_block_num );
+      BOOST_CHECK_EQUAL( j["hits"]["hits"][size_t(0)]["_version"].as_int64(), first_version + 1 );
+   }
+   catch (fc::exception &e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
 BOOST_AUTO_TEST_CASE(elasticsearch_suite) {
    try {
 
@@ -33,6 +33,7 @@
 #include <graphene/db/simple_index.hpp>
 
 #include <fc/crypto/digest.hpp>
+#include <fc/io/json.hpp>
 
 #include "../common/database_fixture.hpp"
 #include <cstdlib>
@@ -40,6 +41,57 @@
 
 using namespace graphene::chain;
 
+namespace {
+
+/// Logs encode and decode speed and encoded size of @p items with JSON and with fc::raw
+template<typename T>
+void compare_json_and_raw( const std::string& name, const std::vector<T>& items, uint32_t cycles )
+{
+   std::vector<std::string> json_data( items.size() );
+   std::vector<std::vector<char>> raw_data( items.size() );
+
+   auto start = fc::time_point::now();
+   for( uint32_t c = 0; c < cycles; ++c )
+      for( size_t i = 0; i < items.size(); ++i )
+         json_data[i] = fc::json::to_string( fc::variant( items[i], GRAPHENE_MAX_NESTED_OBJECTS ) );
+   const auto json_encode = fc::time_point::now() - start;
+
+   start = fc::time_point::now();
+   for( uint32_t c = 0; c < cycles; ++c )
+      for( size_t i = 0; i < items.size(); ++i )
+         fc::json::from_string( json_data[i] ).as<T>( GRAPHENE_MAX_NESTED_OBJECTS );
+   const auto json_decode = fc::time_point::now() - start;
+
+   start = fc::time_point::now();
+   for( uint32_t c = 0; c < cycles; ++c )
+      for( size_t i = 0; i < items.size(); ++i )
+         raw_data[i] = fc::raw::pack( items[i] );
+   const auto raw_encode = fc::time_point::now() - start;
+
+   start = fc::time_point::now();
+   for( uint32_t c = 0; c < cycles; ++c )
+      for( size_t i = 0; i < items.size(); ++i )
+         fc::raw::unpack<T>( raw_data[i] );
+   const auto raw_decode = fc::time_point::now() - start;
+
+   uint64_t json_bytes = 0;
+   uint64_t raw_bytes = 0;
+   for( size_t i = 0; i < items.size(); ++i )
+   {
+      json_bytes += json_data[i].size();
+      raw_bytes += raw_data[i].size();
+   }
+
+   const uint64_t total = items.size() * cycles;
+   wlog( "${n}: JSON encode ${je} ns/item, decode ${jd} ns/item, ${jb} bytes",
+         ("n",name)("je",json_encode.count()*1000/total)("jd",json_decode.count()*1000/total)("jb",json_bytes) );
+   wlog( "${n}: raw encode ${re} ns/item, decode ${rd} ns/item, ${rb} bytes (${hb} bytes hex encoded)",
+         ("n",name)("re",raw_encode.count()*1000/total)("rd",raw_decode.count()*1000/total)
+         ("rb",raw_bytes)("hb",raw_bytes*2) );
+}
+
+} // anonymous namespace
+
 BOOST_FIXTURE_TEST_SUITE( performance_tests, database_fixture )
 
 BOOST_AUTO_TEST_CASE( sigcheck_benchmark )
@@ -208,4 +260,38 @@ BOOST_AUTO_TEST_CASE( one_hundred_k_benchmark )
    db._undo_db.enable();
 } FC_LOG_AND_RETHROW() }
 
+/// Compares the cost of JSON and fc::raw serialization for typical API results
+BOOST_AUTO_TEST_CASE( json_vs_raw_serialization_benchmark )
+{ try {
+   const uint32_t num_accounts = 1000;
+   const uint32_t cycles = 10;
+
+   for( uint32_t i = 0; i < num_accounts; ++i )
+      create_account( "bench" + fc::to_string( i ) );
+   generate_block();
+
+   std::vector<account_object> accounts;
+   for( const auto& a : db.get_index_type<account_index>().indices() )
+      accounts.push_back( a );
+   compare_json_and_raw( "account_object", accounts, cycles );
+
+   const auto& bench0 = get_account( "bench0" );
+   fund( bench0, asset( 10000000 ) );
+   for( uint32_t b = 0; b < 10; ++b )
+   {
+      for( uint32_t i = 1; i < 100; ++i )
+         transfer( bench0.get_id(), get_account( "bench" + fc::to_string( b * 100 + i ) ).get_id(), asset( 10 ) );
+      generate_block();
+   }
+
+   std::vector<signed_block> blocks;
+   for( uint32_t n = 1; n <= db.head_block_num(); ++n )
+   {
+      auto block = db.fetch_block_by_number( n );
+      if( block.valid() && !block->transactions.empty() )
+         blocks.push_back( *block );
+   }
+   compare_json_and_raw( "signed_block", blocks, cycles );
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,547 @@
+/*
+ * Copyright (c) 2026 BitShares Blockchain Foundation, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * Replays a range of recorded blocks on top of a saved chain state and reports the throughput.
+ *
+ * A state directory is the @c blockchain directory of a node which has been shut down, only its object
+ * database is used. Blocks are read from the block log in the @c database directory of another (or the same)
+ * @c blockchain directory. Without a state directory, the replay starts from the genesis state.
+ *
+ * With @c --generate, a synthetic dataset is written instead, so that the benchmark can be run without mainnet
+ * data. Replay it with <tt>--state-dir DIR/state --blocks-dir DIR/blocks</tt>.
+ */
+
+#include <graphene/chain/account_object.hpp>
+#include <graphene/chain/asset_object.hpp>
+#include <graphene/chain/balance_object.hpp>
+#include <graphene/chain/block_database.hpp>
+#include <graphene/chain/config.hpp>
+#include <graphene/chain/database.hpp>
+#include <graphene/chain/market_object.hpp>
+#include <graphene/egenesis/egenesis.hpp>
+#include <graphene/utilities/git_revision.hpp>
+#include <graphene/utilities/tempdir.hpp>
+
+#include <fc/io/fstream.hpp>
+#include <fc/io/json.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <deque>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <tuple>
+
+#ifndef WIN32
+#include <sys/resource.h>
+#endif
+
+using namespace graphene::chain;
+using namespace std;
+namespace bpo = boost::program_options;
+
+// hack:  import create_example_genesis() even though it's a way, way
+// specific internal detail
+namespace graphene { namespace app { namespace detail {
+genesis_state_type create_example_genesis();
+} } } // graphene::app::detail
+
+namespace {
+
+/// Copies @p from to @p to recursively, except the block log
+void copy_state_directory( const fc::path& from, const fc::path& to )
+{
+   namespace bfs = boost::filesystem;
+   const bfs::path& source = from;
+   const bfs::path& target = to;
+   bfs::create_directories( target );
+   for( bfs::recursive_directory_iterator itr( source ), end; itr != end; ++itr )
+   {
+      const bfs::path relative = bfs::relative( itr->path(), source );
+      if( *relative.begin() == "database" )
+         continue;
+      if( bfs::is_directory( itr->path() ) )
+         bfs::create_directories( target / relative );
+      else
+         bfs::copy_file( itr->path(), target / relative );
+   }
+}
+
+uint32_t parse_skip_flags( const string& s )
+{
+   if( s == "none" )
+      return database::skip_nothing;
+   if( s == "revalidate" ) // as witness_node --revalidate-blockchain
+      return database::skip_transaction_signatures;
+   if( s == "replay" ) // as witness_node --replay-blockchain
+      return database::skip_witness_signature
+           | database::skip_block_size_check
+           | database::skip_merkle_check
+           | database::skip_transaction_signatures
+           | database::skip_transaction_dupe_check
+           | database::skip_tapos_check
+           | database::skip_witness_schedule_check;
+   return static_cast<uint32_t>( std::stoul( s, nullptr, 0 ) );
+}
+
+uint64_t peak_rss_bytes()
+{
+#ifndef WIN32
+   struct rusage usage;
+   if( getrusage( RUSAGE_SELF, &usage ) == 0 )
+#ifdef __APPLE__
+      return usage.ru_maxrss;
+#else
+      return uint64_t( usage.ru_maxrss ) * 1024;
+#endif
+#endif
+   return 0;
+}
+
+struct operation_name_visitor
+{
+   typedef string result_type;
+
+   template<typename Type>
+   result_type operator()( const Type& )const
+   {
+      string name = fc::get_typename<Type>::name();
+      size_t p = name.rfind(':');
+      if( p != string::npos )
+         name = name.substr( p+1 );
+      return name;
+   }
+};
+
+/// Builds a synthetic chain with transfer-heavy or market-heavy blocks
+class dataset_generator
+{
+   public:
+      dataset_generator( database& db, uint64_t seed )
+      : _db( db ), _rng( seed | 1 ) {}
+
+      void setup( uint32_t account_count, bool market )
+      {
+         const account_id_type nathan = get_account( "nathan" );
+
+         balance_claim_operation claim;
+         claim.deposit_to_account = nathan;
+         claim.balance_to_claim = balance_id_type();
+         claim.balance_owner_key = _key.get_public_key();
+         claim.total_claimed = balance_id_type()(_db).balance;
+         push( { claim } );
+
+         account_upgrade_operation upgrade;
+         upgrade.account_to_upgrade = nathan;
+         upgrade.upgrade_to_lifetime_member = true;
+         push( { upgrade } );
+         produce_block();
+
+         const uint32_t batch = 50;
+         for( uint32_t i = 0; i < account_count; i += batch )
+         {
+            vector<operation> ops;
+            for( uint32_t j = i; j < std::min( i + batch, account_count ); ++j )
+            {
+               account_create_operation create;
+               create.registrar = nathan;
+               create.referrer = nathan;
+               create.name = "bench-" + std::to_string( j );
+               create.owner = authority( 1, _key.get_public_key(), 1 );
+               create.active = authority( 1, _key.get_public_key(), 1 );
+               create.options.memo_key = _key.get_public_key();
+               create.options.voting_account = GRAPHENE_PROXY_TO_SELF_ACCOUNT;
+               ops.push_back( create );
+            }
+            push( ops );
+         }
+         produce_block();
+         for( uint32_t i = 0; i < account_count; ++i )
+            _accounts.push_back( get_account( "bench-" + std::to_string( i ) ) );
+
+         for( uint32_t i = 0; i < account_count; i += batch )
+         {
+            vector<operation> ops;
+            for( uint32_t j = i; j < std::min( i + batch, account_count ); ++j )
+            {
+               transfer_operation fund;
+               fund.from = nathan;
+               fund.to = _accounts[j];
+               fund.amount = asset( int64_t( GRAPHENE_BLOCKCHAIN_PRECISION * 1000000 ) );
+               ops.push_back( fund );
+            }
+            push( ops );
+         }
+         produce_block();
+
+         if( !market )
+            return;
+
+         asset_create_operation create;
+         create.issuer = nathan;
+         create.symbol = "BENCHMARK";
+         create.precision = GRAPHENE_BLOCKCHAIN_PRECISION_DIGITS;
+         create.common_options.max_supply = GRAPHENE_MAX_SHARE_SUPPLY;
+         create.common_options.core_exchange_rate = price( asset( 1, asset_id_type(1) ), asset( 1 ) );
+         push( { create } );
+         produce_block();
+         _bench_asset = _db.get_index_type<asset_index>().indices().get<by_symbol>().find( "BENCHMARK" )->get_id();
+
+         for( uint32_t i = 0; i < account_count; i += batch )
+         {
+            vector<operation> ops;
+            for( uint32_t j = i; j < std::min( i + batch, account_count ); ++j )
+            {
+               asset_issue_operation issue;
+               issue.issuer = nathan;
+               issue.asset_to_issue = asset( int64_t( GRAPHENE_BLOCKCHAIN_PRECISION * 1000000 ), _bench_asset );
+               issue.issue_to_account = _accounts[j];
+               ops.push_back( issue );
+            }
+            push( ops );
+         }
+         produce_block();
+      }
+
+      void produce_transfer_block( uint32_t transaction_count )
+      {
+         for( uint32_t i = 0; i < transaction_count; ++i )
+         {
+            const size_t from = next_random() % _accounts.size();
+            const size_t to = ( from + 1 + next_random() % ( _accounts.size() - 1 ) ) % _accounts.size();
+            transfer_operation op;
+            op.from = _accounts[from];
+            op.to = _accounts[to];
+            // Unique amounts keep the transactions unique
+            op.amount = asset( int64_t( 1 + _transaction_count ) );
+            push( { op } );
+         }
+         produce_block();
+      }
+
+      void produce_market_block( uint32_t transaction_count )
+      {
+         for( uint32_t i = 0; i < transaction_count; ++i )
+         {
+            // Cancel one old order out of four, the others expire or get filled
+            if( !_open_orders.empty() && next_random() % 4 == 0 )
+            {
+               const auto order = _open_orders.front();
+               _open_orders.pop_front();
+               const limit_order_object* o = _db.find( order );
+               if( o != nullptr )
+               {
+                  limit_order_cancel_operation cancel;
+                  cancel.fee_paying_account = o->seller;
+                  cancel.order = order;
+                  push( { cancel } );
+                  continue;
+               }
+            }
+
+            // Prices spread 5% around 1:1, so about half of the orders get matched
+            const bool sell_core = ( next_random() % 2 == 0 );
+            const int64_t amount = GRAPHENE_BLOCKCHAIN_PRECISION + _transaction_count % 1000;
+            const int64_t receive = amount * int64_t( 95 + next_random() % 11 ) / 100;
+            limit_order_create_operation op;
+            op.seller = _accounts[ next_random() % _accounts.size() ];
+            op.amount_to_sell = asset( amount, sell_core ? asset_id_type() : _bench_asset );
+            op.min_to_receive = asset( receive, sell_core ? _bench_asset : asset_id_type() );
+            op.expiration = _db.head_block_time() + static_cast<uint32_t>( 60 + next_random() % 600 );
+            const processed_transaction result = push( { op } );
+            _open_orders.push_back( limit_order_id_type( result.operation_results[0].get<object_id_type>() ) );
+            if( _open_orders.size() > 10000 )
+               _open_orders.pop_front();
+         }
+         produce_block();
+      }
+
+   private:
+      account_id_type get_account( const string& name )const
+      {
+         const auto& idx = _db.get_index_type<account_index>().indices().get<by_name>();
+         auto itr = idx.find( name );
+         FC_ASSERT( itr != idx.end(), "Account ${n} not found", ("n", name) );
+         return itr->get_id();
+      }
+
+      processed_transaction push( vector<operation> ops )
+      {
+         signed_transaction trx;
+         trx.operations = std::move( ops );
+         for( auto& op : trx.operations )
+            _db.current_fee_schedule().set_fee( op );
+         trx.set_expiration( _db.head_block_time() + fc::minutes(10) );
+         trx.set_reference_block( _db.head_block_id() );
+         trx.sign( _key, _db.get_chain_id() );
+         ++_transaction_count;
+         return _db.push_transaction( precomputable_transaction( trx ) );
+      }
+
+      void produce_block()
+      {
+         _db.generate_block( _db.get_slot_time(1), _db.get_scheduled_witness(1), _key, database::skip_nothing );
+      }
+
+      uint64_t next_random()
+      {
+         // xorshift64
+         _rng ^= _rng << 13;
+         _rng ^= _rng >> 7;
+         _rng ^= _rng << 17;
+         return _rng;
+      }
+
+      database&                        _db;
+      uint64_t                         _rng;
+      const fc::ecc::private_key       _key = fc::ecc::private_key::regenerate( fc::sha256::hash( string("nathan") ) );
+      vector<account_id_type>          _accounts;
+      asset_id_type                    _bench_asset;
+      std::deque<limit_order_id_type>  _open_orders;
+      uint64_t                         _transaction_count = 0;
+};
+
+int generate( const bpo::variables_map& options )
+{
+   const string type = options["generate"].as<string>();
+   FC_ASSERT( type == "transfer" || type == "market", "Unknown dataset type ${t}", ("t", type) );
+   FC_ASSERT( options.count("data-dir") > 0, "data-dir is required" );
+   const fc::path data_dir = options["data-dir"].as<boost::filesystem::path>();
+   FC_ASSERT( !fc::exists( data_dir ), "${d} already exists", ("d", data_dir) );
+
+   genesis_state_type genesis = graphene::app::detail::create_example_genesis();
+   genesis.initial_timestamp = fc::time_point_sec( options["genesis-time"].as<uint32_t>() );
+   genesis.initial_timestamp -= genesis.initial_timestamp.sec_since_epoch() % genesis.initial_parameters.block_interval;
+
+   const uint32_t account_count = options["accounts"].as<uint32_t>();
+   const uint32_t block_count = options["num-blocks"].as<uint32_t>();
+   const uint32_t transactions_per_block = options["transactions-per-block"].as<uint32_t>();
+   FC_ASSERT( account_count >= 2, "At least 2 accounts are needed" );
+
+   const fc::path blocks_dir = data_dir / "blocks";
+   uint32_t first_block = 0;
+   {
+      database db;
+      db.open( blocks_dir, [&genesis]() { return genesis; }, GRAPHENE_CURRENT_DB_VERSION );
+      dataset_generator generator( db, options["seed"].as<uint64_t>() );
+      generator.setup( account_count, type == "market" );
+      db.close( false );
+      copy_state_directory( blocks_dir, data_dir / "state" );
+
+      db.open( blocks_dir, [&genesis]() { return genesis; }, GRAPHENE_CURRENT_DB_VERSION );
+      first_block = db.head_block_num() + 1;
+      std::cerr << "replay_bench: generating " << block_count << " " << type << " blocks from block "
+                << first_block << "\n";
+      for( uint32_t i = 0; i < block_count; ++i )
+      {
+         if( type == "market" )
+            generator.produce_market_block( transactions_per_block );
+         else
+            generator.produce_transfer_block( transactions_per_block );
+      }
+      db.close( false );
+   }
+
+   fc::json::save_to_file( fc::mutable_variant_object( "type", type )
+                                                     ( "accounts", account_count )
+                                                     ( "transactions_per_block", transactions_per_block )
+                                                     ( "seed", options["seed"].as<uint64_t>() )
+                                                     ( "first_block", first_block )
+                                                     ( "last_block", first_block + block_count - 1 ),
+                           data_dir / "dataset.json" );
+   std::cerr << "replay_bench: dataset written to " << data_dir.preferred_string() << "\n";
+   return 0;
+}
+
+int replay( const bpo::variables_map& options )
+{
+   FC_ASSERT( options.count("blocks-dir") > 0, "blocks-dir is required" );
+   const uint32_t skip = parse_skip_flags( options["skip"].as<string>() );
+
+   fc::temp_directory work_dir( options.count("work-dir") > 0
+                                   ? fc::path( options["work-dir"].as<boost::filesystem::path>() )
+                                   : graphene::utilities::temp_directory_path() );
+   const fc::path state_dir = work_dir.path() / "blockchain";
+   if( options.count("state-dir") > 0 )
+      copy_state_directory( options["state-dir"].as<boost::filesystem::path>(), state_dir );
+
+   auto genesis_loader = [&options]() {
+      string genesis_json;
+      if( options.count("genesis-json") > 0 )
+         fc::read_file_contents( options["genesis-json"].as<boost::filesystem::path>(), genesis_json );
+      else
+         graphene::egenesis::compute_egenesis_json( genesis_json );
+      auto genesis = fc::json::from_string( genesis_json ).as<genesis_state_type>( 20 );
+      genesis.initial_chain_id = fc::sha256::hash( genesis_json );
+      return genesis;
+   };
+
+   block_database blocks;
+   blocks.open( fc::path( options["blocks-dir"].as<boost::filesystem::path>() ) / "database" / "block_num_to_block" );
+   const optional<signed_block> last_stored = blocks.last();
+   FC_ASSERT( last_stored.valid(), "The block log is empty" );
+
+   database db;
+   db.open( state_dir, genesis_loader, GRAPHENE_CURRENT_DB_VERSION );
+   if( options.count("profile") > 0 )
+      db.enable_execution_profiler( true );
+
+   const uint32_t first_block = db.head_block_num() + 1;
+   const uint32_t last_block = options.count("last-block") > 0 ? options["last-block"].as<uint32_t>()
+                                                              : last_stored->block_num();
+   FC_ASSERT( first_block <= last_block, "Nothing to replay, the state is at block ${h}", ("h", db.head_block_num()) );
+   std::cerr << "replay_bench: replaying blocks " << first_block << " to " << last_block << "\n";
+
+   // Replay as database::reindex() does, without undo history and with signatures precomputed ahead
+   db._undo_db.disable();
+   uint64_t transaction_count = 0;
+   std::map<int64_t, uint64_t> operation_counts;
+   std::queue< std::pair< signed_block, fc::future<void> > > queue;
+   uint32_t next_block_num = first_block;
+   const fc::time_point start = fc::time_point::now();
+   while( next_block_num <= last_block || !queue.empty() )
+   {
+      if( next_block_num <= last_block && queue.size() < 20 )
+      {
+         optional<signed_block> block = blocks.fetch_by_number( next_block_num );
+         FC_ASSERT( block.valid(), "Block ${n} is missing from the block log", ("n", next_block_num) );
+         ++next_block_num;
+         queue.emplace( std::move(*block), fc::future<void>() );
+         queue.back().second = db.precompute_parallel( queue.back().first, skip );
+         continue;
+      }
+      queue.front().second.wait();
+      const signed_block& block = queue.front().first;
+      db.apply_block( block, skip );
+      transaction_count += block.transactions.size();
+      for( const auto& trx : block.transactions )
+         for( const auto& op : trx.operations )
+            ++operation_counts[op.which()];
+      queue.pop();
+   }
+   const double seconds = double( ( fc::time_point::now() - start ).count() ) / 1000000;
+   db._undo_db.enable();
+
+   const uint32_t block_count = last_block - first_block + 1;
+   uint64_t operation_count = 0;
+   fc::variants operations;
+   for( const auto& entry : operation_counts )
+   {
+      operation op;
+      op.set_which( entry.first );
+      operation_count += entry.second;
+      operations.emplace_back( fc::mutable_variant_object( "type", entry.first )
+                                                         ( "name", op.visit( operation_name_visitor() ) )
+                                                         ( "count", entry.second )
+                                                         ( "per_second", entry.second / seconds ) );
+   }
+
+   fc::mutable_variant_object result;
+   result( "revision", graphene::utilities::git_revision_description )
+         ( "revision_sha", graphene::utilities::git_revision_sha )
+         ( "skip_flags", skip )
+         ( "first_block", first_block )
+         ( "last_block", last_block )
+         ( "blocks", block_count )
+         ( "transactions", transaction_count )
+         ( "operations", operation_count )
+         ( "seconds", seconds )
+         ( "blocks_per_second", block_count / seconds )
+         ( "transactions_per_second", transaction_count / seconds )
+         ( "operations_per_second", operation_count / seconds )
+         ( "operations_by_type", operations )
+         ( "peak_rss_bytes", peak_rss_bytes() );
+   if( options.count("profile") > 0 )
+      result( "profile", fc::variant( db.get_execution_profiler().get_profile(), 10 ) );
+
+   std::cout << fc::json::to_pretty_string( result ) << "\n";
+   if( options.count("output") > 0 )
+      fc::json::save_to_file( result, options["output"].as<boost::filesystem::path>() );
+   return 0;
+}
+
+} // anonymous namespace
+
+int main( int argc, char** argv )
+{
+   try
+   {
+      bpo::options_description cli_options("BitShares replay benchmark");
+      cli_options.add_options()
+            ("help,h", "Print this help message and exit.")
+            ("state-dir,s", bpo::value<boost::filesystem::path>(),
+             "Blockchain directory to take the starting state from, it is copied and not modified. "
+             "Start from the genesis state if omitted")
+            ("blocks-dir,b", bpo::value<boost::filesystem::path>(),
+             "Blockchain directory to read the blocks from. Stop the node which uses it first")
+            ("last-block,l", bpo::value<uint32_t>(), "Last block to replay (the last block of the block log)")
+            ("skip", bpo::value<string>()->default_value("replay"),
+             "Checks to skip: replay, revalidate, none, or a number of database::validation_steps flags")
+            ("genesis-json,g", bpo::value<boost::filesystem::path>(),
+             "File to read the genesis state from when there is no state directory (embedded genesis)")
+            ("work-dir", bpo::value<boost::filesystem::path>(), "Directory for the temporary copy of the state")
+            ("profile", "Include the execution profile of operations and blocks in the results")
+            ("output,o", bpo::value<boost::filesystem::path>(), "File to save the results to in JSON format")
+            ("generate", bpo::value<string>(),
+             "Write a synthetic dataset of this type to data-dir instead of replaying: transfer or market")
+            ("data-dir,d", bpo::value<boost::filesystem::path>(), "Directory to write the synthetic dataset to")
+            ("accounts", bpo::value<uint32_t>()->default_value(1000), "Number of accounts in the synthetic dataset")
+            ("num-blocks,n", bpo::value<uint32_t>()->default_value(1000), "Number of blocks in the synthetic dataset")
+            ("transactions-per-block", bpo::value<uint32_t>()->default_value(200),
+             "Number of transactions per block in the synthetic dataset")
+            ("genesis-time", bpo::value<uint32_t>()->default_value(1700000000),
+             "Timestamp of the genesis state of the synthetic dataset")
+            ("seed", bpo::value<uint64_t>()->default_value(1), "Seed of the synthetic dataset")
+            ;
+
+      bpo::variables_map options;
+      try
+      {
+         bpo::store( bpo::parse_command_line(argc, argv, cli_options), options );
+      }
+      catch (const bpo::error& e)
+      {
+         std::cerr << "replay_bench:  error parsing command line: " << e.what() << "\n";
+         return 1;
+      }
+
+      if( options.count("help") )
+      {
+         std::cout << cli_options << "\n";
+         return 0;
+      }
+
+      if( options.count("generate") > 0 )
+         return generate( options );
+      return replay( options );
+   }
+   catch ( const fc::exception& e )
+   {
+      std::cerr << e.to_detail_string() << "\n";
+      return 1;
+   }
+}
@@ -36,8 +36,12 @@
 #include <graphene/chain/witness_schedule_object.hpp>
 #include <graphene/chain/witness_object.hpp>
 
+#include <graphene/net/core_messages.hpp>
+
 #include <graphene/utilities/tempdir.hpp>
 
+#include <graphene/witness/witness.hpp>
+
 #include <fc/crypto/digest.hpp>
 #include <fc/io/fstream.hpp>
 
@@ -101,8 +105,18 @@ BOOST_AUTO_TEST_CASE( block_database_test )
          fetch = bdb.fetch_optional( b.id() );
          FC_ASSERT( fetch.valid() );
          FC_ASSERT( fetch->witness ==  b.witness );
+
+         auto packed = bdb.fetch_packed_optional( b.id() );
+         FC_ASSERT( packed.valid() );
+         FC_ASSERT( *packed == fc::raw::pack( static_cast<const signed_block&>( b ) ) );
+         packed = bdb.fetch_packed_by_number( b.block_num() );
+         FC_ASSERT( packed.valid() );
+         FC_ASSERT( *packed == fc::raw::pack( static_cast<const signed_block&>( b ) ) );
       }
 
+      FC_ASSERT( !bdb.fetch_packed_by_number( 6 ).valid() );
+      FC_ASSERT( !bdb.fetch_packed_optional( block_id_type() ).valid() );
+
       for( uint32_t i = 1; i < 5; ++i )
       {
          auto blk = bdb.fetch_by_number( i );
@@ -133,6 +147,36 @@ BOOST_AUTO_TEST_CASE( block_database_test )
    }
 }
 
+BOOST_FIXTURE_TEST_CASE( packed_block_message_test, database_fixture )
+{
+   try {
+      ACTORS((alice));
+      transfer( committee_account, alice_id, asset(1000) );
+      generate_block();
+
+      const auto block = db.fetch_block_by_number( db.head_block_num() );
+      BOOST_REQUIRE( block.valid() );
+      BOOST_REQUIRE( !block->transactions.empty() );
+      const auto block_id = block->id();
+
+      const auto packed = db.fetch_packed_block_by_id( block_id );
+      BOOST_REQUIRE( packed.valid() );
+
+      // same as a block_message built from the unpacked block
+      const graphene::net::message expected = graphene::net::block_message( *block );
+      const graphene::net::message msg = graphene::net::block_message::from_packed_block( *packed, block_id );
+      BOOST_CHECK_EQUAL( msg.msg_type.value(), expected.msg_type.value() );
+      BOOST_CHECK_EQUAL( msg.size.value(), expected.size.value() );
+      BOOST_CHECK( msg.data == expected.data );
+
+      const auto unpacked = msg.as<graphene::net::block_message>();
+      BOOST_CHECK( unpacked.block_id == block_id );
+      BOOST_CHECK( unpacked.block.id() == block_id );
+
+      BOOST_CHECK( !db.fetch_packed_block_by_id( block_id_type() ).valid() );
+   } FC_LOG_AND_RETHROW()
+}
+
 BOOST_AUTO_TEST_CASE( generate_empty_blocks )
 {
    try {
@@ -727,13 +771,27 @@ BOOST_AUTO_TEST_CASE( duplicate_transactions )
 
       GRAPHENE_CHECK_THROW(PUSH_TX( db1, trx, skip_sigs ), fc::exception);
 
+      // pending transactions are served from the pending queue
+      BOOST_CHECK( db1.is_known_transaction( trx.id() ) );
+      BOOST_CHECK( db1.get_recent_transaction( trx.id() ).id() == trx.id() );
+      BOOST_CHECK( !db2.is_known_transaction( trx.id() ) );
+      GRAPHENE_CHECK_THROW( db2.get_recent_transaction( trx.id() ), fc::exception );
+
       auto b = db1.generate_block( db1.get_slot_time(1), db1.get_scheduled_witness( 1 ), init_account_priv_key, skip_sigs );
       PUSH_BLOCK( db2, b, skip_sigs );
 
       GRAPHENE_CHECK_THROW(PUSH_TX( db1, trx, skip_sigs ), fc::exception);
       GRAPHENE_CHECK_THROW(PUSH_TX( db2, trx, skip_sigs ), fc::exception);
+
+      // included transactions are served from the block
+      BOOST_CHECK( db1.get_recent_transaction( trx.id() ).id() == trx.id() );
+      BOOST_CHECK( db2.get_recent_transaction( trx.id() ).id() == trx.id() );
       BOOST_CHECK_EQUAL(db1.get_balance(nathan_id, asset_id_type()).amount.value, 500);
       BOOST_CHECK_EQUAL(db2.get_balance(nathan_id, asset_id_type()).amount.value, 500);
+
+      // popping the block forgets the transaction
+      db2.pop_block();
+      BOOST_CHECK( !db2.is_known_transaction( trx.id() ) );
    } catch (fc::exception& e) {
       edump((e.to_detail_string()));
       throw;
@@ -1949,4 +2007,36 @@ BOOST_FIXTURE_TEST_CASE( block_size_test, database_fixture )
    }
 }
 
+BOOST_FIXTURE_TEST_CASE( witness_production_wakeup, database_fixture )
+{
+   try
+   {
+      using graphene::witness_plugin::witness_plugin;
+
+      const fc::time_point slot_1 = db.get_slot_time(1);
+      const fc::time_point slot_2 = db.get_slot_time(2);
+      const fc::microseconds max_lead = fc::milliseconds( witness_plugin::max_production_lead_time_ms );
+
+      for( const fc::microseconds& lead : { fc::microseconds(), fc::milliseconds(200), max_lead } )
+      {
+         // well ahead of the slot, wake up the lead time before it
+         fc::time_point wakeup = witness_plugin::next_production_wakeup( db, slot_1 - fc::seconds(1) - lead, lead );
+         BOOST_CHECK( wakeup == slot_1 - lead );
+
+         // maybe_produce_block() rounds to the slot, even when the loop runs a bit late
+         BOOST_CHECK( fc::time_point_sec( wakeup + fc::milliseconds(500) ) == fc::time_point_sec( slot_1 ) );
+         BOOST_CHECK( fc::time_point_sec( wakeup + fc::milliseconds(590) ) == fc::time_point_sec( slot_1 ) );
+
+         // less than 50ms to wait, take the slot after that
+         wakeup = witness_plugin::next_production_wakeup( db, slot_1 - lead - fc::milliseconds(40), lead );
+         BOOST_CHECK( wakeup == slot_2 - lead );
+      }
+   }
+   catch( fc::exception& e )
+   {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -454,6 +454,45 @@ BOOST_AUTO_TEST_CASE(container_in_not_in_checks) { try {
    BOOST_CHECK(!pred(op));
 } FC_LOG_AND_RETHROW() }
 
+BOOST_AUTO_TEST_CASE(shared_restriction_predicate_checks) { try {
+   vector<restriction> restrictions;
+   restrictions.emplace_back(member_index<transfer_operation>("to"), FUNC(eq), account_id_type(12));
+   auto pred = get_shared_restriction_predicate(restrictions, operation::tag<transfer_operation>::value);
+   BOOST_REQUIRE(pred);
+
+   // Identical restrictions for the same operation type share the predicate
+   BOOST_CHECK(get_shared_restriction_predicate(restrictions, operation::tag<transfer_operation>::value) == pred);
+   BOOST_CHECK(get_shared_restriction_predicate(restrictions, operation::tag<override_transfer_operation>::value)
+               != pred);
+   restrictions.front().argument = account_id_type(13);
+   auto other = get_shared_restriction_predicate(restrictions, operation::tag<transfer_operation>::value);
+   BOOST_CHECK(other != pred);
+
+   transfer_operation op;
+   op.to = account_id_type(12);
+   BOOST_CHECK((*pred)(op));
+   BOOST_CHECK(!(*other)(op));
+   auto result = (*other)(op);
+   BOOST_REQUIRE_EQUAL(result.rejection_path.size(), 2u);
+   BOOST_CHECK(result.rejection_path[0].get<size_t>() == 0);
+   BOOST_CHECK(result.rejection_path[1].get<predicate_result::rejection_reason>() == predicate_result::predicate_was_false);
+
+   // Sweeping the predicates nobody uses any more keeps those still in use
+   for (uint64_t i = 100; i < 400; ++i) {
+      restrictions.front().argument = account_id_type(i);
+      BOOST_CHECK(get_shared_restriction_predicate(restrictions, operation::tag<transfer_operation>::value));
+   }
+   restrictions.front().argument = account_id_type(12);
+   BOOST_CHECK(get_shared_restriction_predicate(restrictions, operation::tag<transfer_operation>::value) == pred);
+   restrictions.front().argument = account_id_type(13);
+   BOOST_CHECK(get_shared_restriction_predicate(restrictions, operation::tag<transfer_operation>::value) == other);
+
+   // Invalid restrictions are rejected and not cached
+   restrictions.front().argument = string("invalid");
+   GRAPHENE_REQUIRE_THROW(get_shared_restriction_predicate(restrictions, operation::tag<transfer_operation>::value),
+                          fc::assert_exception);
+} FC_LOG_AND_RETHROW() }
+
    /**
     * Test predicates containing logical ORs
     * Test of authorization and revocation of one account (Alice) authorizing multiple other accounts (Bob and Charlie)
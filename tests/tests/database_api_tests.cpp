@@ -1910,4 +1910,195 @@ BOOST_AUTO_TEST_CASE( get_trade_history )
 } FC_LOG_AND_RETHROW() }
 
 
+BOOST_AUTO_TEST_CASE( get_packed_objects )
+{ try {
+   ACTORS((alice));
+
+   const auto& usd = create_user_issued_asset("USD");
+   generate_block();
+
+   graphene::app::database_api db_api( db, &( app.get_options() ) );
+
+   vector<object_id_type> ids { alice_id, usd.id, object_id_type( account_id_type( 1000000 ) ) };
+   const auto packed = db_api.get_packed_objects( ids );
+   const auto variants = db_api.get_objects( ids );
+
+   BOOST_REQUIRE_EQUAL( packed.size(), 3u );
+   BOOST_REQUIRE( packed[0].valid() );
+   BOOST_REQUIRE( packed[1].valid() );
+   BOOST_CHECK( !packed[2].valid() );
+   BOOST_CHECK( variants[2].is_null() );
+
+   BOOST_CHECK( packed[0]->id == ids[0] );
+   const auto alice_obj = fc::raw::unpack<account_object>( packed[0]->data );
+   BOOST_CHECK( alice_obj.id == ids[0] );
+   BOOST_CHECK_EQUAL( alice_obj.name, "alice" );
+   BOOST_CHECK_EQUAL( fc::json::to_string( fc::variant( alice_obj, GRAPHENE_MAX_NESTED_OBJECTS ) ),
+                      fc::json::to_string( variants[0] ) );
+
+   BOOST_CHECK( packed[1]->id == ids[1] );
+   const auto usd_obj = fc::raw::unpack<asset_object>( packed[1]->data );
+   BOOST_CHECK_EQUAL( usd_obj.symbol, "USD" );
+   BOOST_CHECK_EQUAL( fc::json::to_string( fc::variant( usd_obj, GRAPHENE_MAX_NESTED_OBJECTS ) ),
+                      fc::json::to_string( variants[1] ) );
+
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( stream_accounts_and_limit_orders )
+{ try {
+
+   graphene::app::application_options opt = app.get_options();
+   opt.enable_api_streams = true;
+   opt.api_limit_lookup_accounts = 3;
+   opt.api_limit_get_limit_orders = 2;
+   graphene::app::database_api db_api( db, &opt );
+
+   ACTORS((bob)(alice));
+
+   const auto& eur = create_user_issued_asset("EUR");
+   const auto& usd = create_user_issued_asset("USD");
+
+   issue_uia( bob_id, usd.amount(1000000) );
+   issue_uia( alice_id, eur.amount(1000000) );
+
+   // non-crossing orders on both sides
+   create_sell_order( bob, usd.amount(100), eur.amount(200) );
+   create_sell_order( bob, usd.amount(100), eur.amount(150) );
+   create_sell_order( bob, usd.amount(100), eur.amount(300) );
+   create_sell_order( alice, eur.amount(100), usd.amount(100) );
+   create_sell_order( alice, eur.amount(100), usd.amount(90) );
+
+   generate_block();
+
+   vector<variant> pages;
+   bool finished = false;
+   auto callback = [&db_api,&pages,&finished]( const variant& v ) {
+      if( v.is_null() )
+         finished = true;
+      else
+      {
+         pages.push_back( v );
+         db_api.ack_stream_pages( 1 );
+      }
+   };
+
+   // accounts
+   db_api.stream_accounts( callback, "" );
+   fc::usleep(fc::milliseconds(200)); // sleep a while to execute callback in another task
+
+   BOOST_CHECK( finished );
+   vector<string> names;
+   for( const auto& page : pages )
+   {
+      const auto entries = page.as<vector<pair<string,account_id_type>>>( 3 );
+      BOOST_CHECK_LE( entries.size(), 3u );
+      for( const auto& entry : entries )
+         names.push_back( entry.first );
+   }
+   BOOST_CHECK_EQUAL( names.size(), db_api.get_account_count() );
+   BOOST_CHECK( std::is_sorted( names.begin(), names.end() ) );
+   BOOST_CHECK( std::adjacent_find( names.begin(), names.end() ) == names.end() );
+
+   // order book
+   pages.clear();
+   finished = false;
+   db_api.stream_limit_orders( callback, "USD", "EUR" );
+   fc::usleep(fc::milliseconds(200)); // sleep a while to execute callback in another task
+
+   BOOST_CHECK( finished );
+   vector<limit_order_object> orders;
+   for( const auto& page : pages )
+   {
+      const auto page_orders = page.as<vector<limit_order_object>>( GRAPHENE_MAX_NESTED_OBJECTS );
+      BOOST_CHECK_LE( page_orders.size(), 2u );
+      orders.insert( orders.end(), page_orders.begin(), page_orders.end() );
+   }
+   BOOST_REQUIRE_EQUAL( orders.size(), 5u );
+   for( size_t i = 0; i < 3; ++i )
+      BOOST_CHECK( orders[i].sell_price.base.asset_id == usd.id );
+   for( size_t i = 3; i < 5; ++i )
+      BOOST_CHECK( orders[i].sell_price.base.asset_id == eur.id );
+   BOOST_CHECK_EQUAL( orders[0].sell_price.quote.amount.value, 150 );
+   BOOST_CHECK_EQUAL( orders[1].sell_price.quote.amount.value, 200 );
+   BOOST_CHECK_EQUAL( orders[2].sell_price.quote.amount.value, 300 );
+   BOOST_CHECK_EQUAL( orders[3].sell_price.quote.amount.value, 90 );
+   BOOST_CHECK_EQUAL( orders[4].sell_price.quote.amount.value, 100 );
+
+   // a cancelled stream sends nothing
+   pages.clear();
+   finished = false;
+   db_api.stream_accounts( callback, "" );
+   db_api.cancel_stream();
+   fc::usleep(fc::milliseconds(200)); // sleep a while to execute callback in another task
+
+   BOOST_CHECK( pages.empty() );
+   BOOST_CHECK( !finished );
+
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( stream_flow_control )
+{ try {
+
+   graphene::app::application_options opt = app.get_options();
+   opt.api_limit_lookup_accounts = 2;
+   opt.api_limit_stream_pages_in_flight = 3;
+   graphene::app::database_api db_api( db, &opt );
+
+   vector<variant> pages;
+   bool finished = false;
+   auto callback = [&pages,&finished]( const variant& v ) {
+      if( v.is_null() )
+         finished = true;
+      else
+         pages.push_back( v );
+   };
+
+   // streams are disabled by default
+   BOOST_CHECK( !app.get_options().enable_api_streams );
+   GRAPHENE_CHECK_THROW( db_api.stream_accounts( callback, "" ), fc::exception );
+   opt.enable_api_streams = true;
+
+   // the stream stops once 3 pages are not acknowledged
+   BOOST_REQUIRE_GT( db_api.get_account_count(), 8u );
+   db_api.stream_accounts( callback, "" );
+   fc::usleep(fc::milliseconds(200)); // sleep a while to execute callback in another task
+   BOOST_CHECK_EQUAL( pages.size(), 3u );
+   BOOST_CHECK( !finished );
+
+   // and goes on as far as the acknowledged pages allow
+   db_api.ack_stream_pages( 2 );
+   fc::usleep(fc::milliseconds(200));
+   BOOST_CHECK_EQUAL( pages.size(), 5u );
+   GRAPHENE_CHECK_THROW( db_api.ack_stream_pages( 4 ), fc::exception );
+
+   size_t acknowledged = 2;
+   for( int i = 0; i < 100 && !finished; ++i )
+   {
+      db_api.ack_stream_pages( pages.size() - acknowledged );
+      acknowledged = pages.size();
+      fc::usleep(fc::milliseconds(20));
+   }
+   BOOST_CHECK( finished );
+   size_t names = 0;
+   for( const auto& page : pages )
+      names += page.get_array().size();
+   BOOST_CHECK_EQUAL( names, db_api.get_account_count() );
+
+   // a page is sent alone if the byte budget does not allow more
+   opt.api_limit_stream_bytes_in_flight = 1;
+   pages.clear();
+   finished = false;
+   db_api.stream_accounts( callback, "" );
+   fc::usleep(fc::milliseconds(200));
+   BOOST_CHECK_EQUAL( pages.size(), 1u );
+   db_api.ack_stream_pages( 1 );
+   fc::usleep(fc::milliseconds(200));
+   BOOST_CHECK_EQUAL( pages.size(), 2u );
+
+   // cancelling drops the unacknowledged pages
+   db_api.cancel_stream();
+   GRAPHENE_CHECK_THROW( db_api.ack_stream_pages( 1 ), fc::exception );
+
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -27,9 +27,14 @@
 #include <graphene/chain/database.hpp>
 
 #include <graphene/chain/account_object.hpp>
+#include <graphene/chain/genesis_state.hpp>
+#include <graphene/chain/market_object.hpp>
 #include <graphene/chain/proposal_object.hpp>
 
+#include <graphene/utilities/tempdir.hpp>
+
 #include <fc/crypto/digest.hpp>
+#include <fc/io/json.hpp>
 
 #include "../common/database_fixture.hpp"
 
@@ -223,6 +228,81 @@ BOOST_AUTO_TEST_CASE( direct_index_test )
    // but the secondary has not updated its representation
 } FC_LOG_AND_RETHROW() }
 
+BOOST_AUTO_TEST_CASE( hash_index_test )
+{ try {
+   graphene::db::primary_index< limit_order_index > my_orders( db );
+
+   limit_order_object test_order;
+   test_order.id = limit_order_id_type(1);
+   my_orders.load( fc::raw::pack( test_order ) );
+
+   // objects that are already in the index are picked up
+   my_orders.use_hash_index();
+   BOOST_CHECK_THROW( my_orders.use_hash_index(), fc::assert_exception );
+   const auto& hashed = my_orders.get_secondary_index< graphene::db::hash_index< limit_order_object > >();
+   BOOST_CHECK_EQUAL( 1u, hashed.size() );
+   BOOST_CHECK( nullptr != my_orders.find( limit_order_id_type(1) ) );
+   BOOST_CHECK( nullptr == my_orders.find( limit_order_id_type(0) ) );
+   BOOST_CHECK_THROW( hashed.find( object_id_type( asset_id_type(1) ) ), fc::assert_exception );
+
+   // large holes are fine
+   test_order.id = limit_order_id_type(1000000);
+   my_orders.load( fc::raw::pack( test_order ) );
+   test_order.id = limit_order_id_type(1000001);
+   my_orders.load( fc::raw::pack( test_order ) );
+   BOOST_CHECK_EQUAL( 3u, hashed.size() );
+   BOOST_CHECK( nullptr != my_orders.find( limit_order_id_type(1000000) ) );
+   BOOST_CHECK( nullptr == my_orders.find( limit_order_id_type(999999) ) );
+   BOOST_CHECK( nullptr == my_orders.find( limit_order_id_type(2000000) ) );
+   GRAPHENE_REQUIRE_THROW( my_orders.load( fc::raw::pack( test_order ) ), fc::exception );
+
+   // removed objects are forgotten
+   my_orders.remove( *my_orders.find( limit_order_id_type(1) ) );
+   BOOST_CHECK( nullptr == my_orders.find( limit_order_id_type(1) ) );
+   my_orders.remove( *my_orders.find( limit_order_id_type(1000000) ) );
+   BOOST_CHECK_EQUAL( 1u, hashed.size() );
+   BOOST_CHECK( nullptr != my_orders.find( limit_order_id_type(1000001) ) );
+
+   my_orders.modify( *my_orders.find( limit_order_id_type(1000001) ), [] ( object& o ) {
+      static_cast< limit_order_object& >( o ).for_sale = 100;
+   });
+   BOOST_CHECK_EQUAL( 100, static_cast< const limit_order_object* >(
+                              my_orders.find( limit_order_id_type(1000001) ) )->for_sale.value );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( secondary_index_lookup_test )
+{ try {
+   struct counting_index : public graphene::db::secondary_index
+   {
+      uint32_t inserted = 0;
+      void object_inserted( const object& ) override { ++inserted; }
+   };
+   struct other_counting_index : public counting_index {};
+   struct unused_index : public graphene::db::secondary_index {};
+
+   graphene::db::primary_index< account_index > my_accounts( db );
+   auto first = my_accounts.add_secondary_index< counting_index >();
+   auto second = my_accounts.add_secondary_index< other_counting_index >();
+   auto duplicate = my_accounts.add_secondary_index< counting_index >();
+
+   BOOST_CHECK( &my_accounts.get_secondary_index< counting_index >() == first );
+   BOOST_CHECK( &my_accounts.get_secondary_index< other_counting_index >() == second );
+   // base classes are found by scanning, the first matching index wins
+   BOOST_CHECK( &my_accounts.get_secondary_index< graphene::db::secondary_index >() == first );
+   BOOST_CHECK_THROW( my_accounts.get_secondary_index< unused_index >(), fc::assert_exception );
+
+   my_accounts.create( [] ( object& o ) {
+      static_cast< account_object& >( o ).name = "account0";
+   } );
+   BOOST_CHECK_EQUAL( 1u, first->inserted );
+   BOOST_CHECK_EQUAL( 1u, second->inserted );
+   BOOST_CHECK_EQUAL( 1u, duplicate->inserted );
+
+   // the lookup slots are per primary index
+   graphene::db::primary_index< account_index > other_accounts( db );
+   BOOST_CHECK_THROW( other_accounts.get_secondary_index< counting_index >(), fc::assert_exception );
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_CASE( required_approval_index_test ) // see https://github.com/bitshares/bitshares-core/issues/1719
 { try {
    ACTORS( (alice)(bob)(charlie)(agnetha)(benny)(carlos) );
@@ -310,4 +390,173 @@ BOOST_AUTO_TEST_CASE( required_approval_index_test ) // see https://github.com/b
 
 } FC_LOG_AND_RETHROW() }
 
+BOOST_AUTO_TEST_CASE( execution_profiler_test )
+{ try {
+   ACTORS( (alice)(bob) );
+   fund( alice, asset(1000000) );
+   generate_block();
+
+   BOOST_CHECK( !db.get_execution_profiler().is_enabled() );
+   db.enable_execution_profiler( true );
+   BOOST_CHECK( db.get_execution_profiler().is_enabled() );
+
+   set_expiration( db, trx );
+   transfer( alice_id, bob_id, asset(1000) );
+   generate_block();
+
+   execution_profile profile = db.get_execution_profiler().get_profile();
+
+   const int64_t transfer_type = operation::tag<transfer_operation>::value;
+   auto op_itr = std::find_if( profile.operations.begin(), profile.operations.end(),
+                               [transfer_type]( const operation_execution_profile& p ) {
+                                  return p.operation_type == transfer_type;
+                               } );
+   BOOST_REQUIRE( op_itr != profile.operations.end() );
+   BOOST_CHECK_EQUAL( op_itr->operation_name, "transfer_operation" );
+   BOOST_CHECK_GE( op_itr->total.count, 1u );
+   BOOST_CHECK_EQUAL( op_itr->apply.count, op_itr->total.count );
+   BOOST_REQUIRE_EQUAL( op_itr->total.buckets.size(), size_t( execution_time_histogram::bucket_count ) );
+   uint64_t bucket_sum = 0;
+   for( uint64_t n : op_itr->total.buckets )
+      bucket_sum += n;
+   BOOST_CHECK_EQUAL( bucket_sum, op_itr->total.count );
+
+   BOOST_REQUIRE_EQUAL( profile.recent_blocks.size(), 1u );
+   const block_execution_profile& block = profile.recent_blocks.front();
+   BOOST_CHECK_EQUAL( block.block_num, db.head_block_num() );
+   BOOST_CHECK_EQUAL( block.transactions, 1u );
+   auto changes_itr = std::find_if( block.object_changes.begin(), block.object_changes.end(),
+                                    []( const index_change_counts& c ) {
+                                       return c.space_id == account_balance_object::space_id
+                                              && c.type_id == account_balance_object::type_id;
+                                    } );
+   BOOST_REQUIRE( changes_itr != block.object_changes.end() );
+   BOOST_CHECK_GE( changes_itr->modified + changes_itr->created, 2u );
+
+   BOOST_REQUIRE_EQUAL( profile.slowest_transactions.size(), 1u );
+   BOOST_CHECK_EQUAL( profile.slowest_transactions.front().block_num, db.head_block_num() );
+   BOOST_CHECK_EQUAL( profile.slowest_transactions.front().operations, 1u );
+
+   // Nothing is collected while disabled
+   db.enable_execution_profiler( false );
+   generate_block();
+   profile = db.get_execution_profiler().get_profile();
+   BOOST_CHECK_EQUAL( profile.recent_blocks.size(), 1u );
+
+   // Enabling again discards the old data
+   db.enable_execution_profiler( true );
+   profile = db.get_execution_profiler().get_profile();
+   BOOST_CHECK( profile.operations.empty() );
+   BOOST_CHECK( profile.recent_blocks.empty() );
+   BOOST_CHECK( profile.slowest_transactions.empty() );
+
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( index_inspection_test )
+{ try {
+   ACTOR( alice );
+
+   size_t inspected = 0;
+   db.inspect_all_indexes( [this,&inspected]( const graphene::db::index& idx ) {
+      ++inspected;
+      if( idx.object_space_id() == protocol_ids && idx.object_type_id() == account_object_type )
+      {
+         BOOST_CHECK_EQUAL( idx.object_count(), db.get_index_type< account_index >().indices().size() );
+         BOOST_CHECK_EQUAL( idx.object_size(), sizeof( account_object ) );
+      }
+      else if( idx.object_space_id() == implementation_ids && idx.object_type_id() == impl_dynamic_global_property_object_type )
+         BOOST_CHECK_EQUAL( idx.object_count(), 1u );
+   } );
+   BOOST_CHECK( inspected > 0 );
+
+   const auto blocks_before = db.get_block_processing_counters().blocks;
+   generate_block();
+   BOOST_CHECK_EQUAL( db.get_block_processing_counters().blocks, blocks_before + 1 );
+   BOOST_CHECK_EQUAL( db.get_pending_transaction_count(), 0u );
+
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( block_tracer_test )
+{ try {
+   fc::temp_directory trace_dir( graphene::utilities::temp_directory_path() );
+   const auto trace_file = [&trace_dir]( uint32_t block_num ) {
+      return trace_dir.path() / ( "block-" + std::to_string( block_num ) + ".json" );
+   };
+
+   BOOST_CHECK( !db.get_block_tracer().is_enabled() );
+
+   ACTOR( alice );
+   const uint32_t traced_block = db.head_block_num() + 1;
+   db.get_block_tracer().enable( trace_dir.path(), traced_block, traced_block, fc::microseconds() );
+   generate_block();
+   BOOST_CHECK( db.get_recording_block_tracer() == nullptr );
+   generate_block();
+
+   BOOST_REQUIRE( fc::exists( trace_file( traced_block ) ) );
+   BOOST_CHECK( !fc::exists( trace_file( traced_block + 1 ) ) );
+
+   const fc::variant trace = fc::json::from_file( trace_file( traced_block ) );
+   std::set<string> names;
+   for( const auto& event : trace.get_object()["traceEvents"].get_array() )
+   {
+      BOOST_CHECK_EQUAL( event.get_object()["ph"].as_string(), "X" );
+      names.insert( event.get_object()["name"].as_string() );
+   }
+   BOOST_CHECK( names.count( "apply_block" ) > 0 );
+   BOOST_CHECK( names.count( "transactions" ) > 0 );
+   BOOST_CHECK( names.count( "transaction" ) > 0 );
+   BOOST_CHECK( names.count( "clear_expired_orders" ) > 0 );
+   BOOST_CHECK( names.count( "applied_block_handlers" ) > 0 );
+   BOOST_CHECK( names.count( "notify_changed_objects" ) > 0 );
+
+   // Every block takes longer than the threshold
+   db.get_block_tracer().enable( trace_dir.path(), 0, 0, fc::microseconds(1) );
+   generate_block();
+   BOOST_CHECK( fc::exists( trace_file( db.head_block_num() ) ) );
+
+   db.get_block_tracer().disable();
+   generate_block();
+   BOOST_CHECK( !fc::exists( trace_file( db.head_block_num() ) ) );
+
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( genesis_parallel_conversion_test )
+{ try {
+   genesis_state_type genesis;
+   genesis.initial_timestamp = fc::time_point_sec( 1431700000 );
+   // more than one chunk of each list
+   for( int i = 0; i < 2500; ++i )
+   {
+      const auto key = public_key_type( fc::ecc::private_key::regenerate( fc::digest( i ) ).get_public_key() );
+      genesis.initial_accounts.emplace_back( "account" + fc::to_string( i ), key, key, i % 2 == 0 );
+      genesis.initial_balances.push_back( { address( key ), GRAPHENE_SYMBOL, share_type( i + 1 ) } );
+   }
+   genesis_state_type::initial_vesting_balance_type vest;
+   vest.owner = address( genesis.initial_accounts.front().owner_key );
+   vest.asset_symbol = GRAPHENE_SYMBOL;
+   vest.amount = 100;
+   vest.begin_timestamp = genesis.initial_timestamp;
+   vest.vesting_duration_seconds = 3600;
+   vest.begin_balance = 100;
+   genesis.initial_vesting_balances.push_back( vest );
+   genesis.initial_witness_candidates.push_back( { "account0", genesis.initial_accounts.front().owner_key } );
+
+   const fc::variant var( genesis, 20 );
+   const auto parallel = genesis_state_type::from_variant_parallel( var, 20 );
+   const auto sequential = var.as<genesis_state_type>( 20 );
+   const std::string expected = fc::json::to_string( var );
+   BOOST_CHECK_EQUAL( fc::json::to_string( fc::variant( parallel, 20 ) ), expected );
+   BOOST_CHECK_EQUAL( fc::json::to_string( fc::variant( sequential, 20 ) ), expected );
+
+   // errors in any chunk are passed on
+   fc::mutable_variant_object obj( var.get_object() );
+   fc::variants accounts = obj["initial_accounts"].get_array();
+   fc::mutable_variant_object bad_account( accounts.back().get_object() );
+   bad_account["owner_key"] = "not a key";
+   accounts.back() = fc::variant( bad_account );
+   obj["initial_accounts"] = fc::variant( accounts );
+   BOOST_CHECK_THROW( genesis_state_type::from_variant_parallel( fc::variant( obj ), 20 ), fc::exception );
+
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2026 BitShares Blockchain Foundation, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+
+#include <graphene/delta_stream/delta_stream_plugin.hpp>
+
+#include <fc/io/json.hpp>
+
+#include "../common/database_fixture.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+using namespace graphene::chain;
+using namespace graphene::chain::test;
+
+namespace {
+
+/// the stream files in stream order
+vector<string> delta_stream_files( const fc::path& dir )
+{
+   vector<string> files;
+   for( boost::filesystem::directory_iterator itr( dir.generic_string() ), end; itr != end; ++itr )
+      files.push_back( itr->path().generic_string() );
+   std::sort( files.begin(), files.end() );
+   return files;
+}
+
+fc::variants read_records( const string& file )
+{
+   fc::variants records;
+   std::ifstream in( file );
+   string line;
+   while( std::getline( in, line ) )
+      records.push_back( fc::json::from_string( line ) );
+   return records;
+}
+
+fc::variants read_delta_stream( const fc::path& dir )
+{
+   fc::variants records;
+   for( const string& file : delta_stream_files( dir ) )
+   {
+      fc::variants file_records = read_records( file );
+      std::move( file_records.begin(), file_records.end(), std::back_inserter( records ) );
+   }
+   return records;
+}
+
+const variant& last_record_of_type( const fc::variants& records, const string& type )
+{
+   auto itr = std::find_if( records.rbegin(), records.rend(), [&type]( const variant& r ) {
+      return r["type"].as_string() == type;
+   } );
+   FC_ASSERT( itr != records.rend(), "No ${t} record", ("t",type) );
+   return *itr;
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE( delta_stream_tests, database_fixture )
+
+BOOST_AUTO_TEST_CASE( delta_stream_test )
+{ try {
+   const fc::path dir = data_dir.path() / "delta_stream";
+
+   // every block is written with the objects it created or changed, after their notifications
+   ACTOR( alice );
+   generate_block();
+
+   fc::variants records = read_delta_stream( dir );
+   {
+      const variant& block = last_record_of_type( records, "block" );
+      BOOST_CHECK_EQUAL( block["num"].as_uint64(), db.head_block_num() );
+      BOOST_CHECK( block["id"].as<block_id_type>( 1 ) == db.head_block_id() );
+      const string alice = string( object_id_type( alice_id ) );
+      const auto& objects = block["objects"].get_array();
+      BOOST_CHECK( std::any_of( objects.begin(), objects.end(), [&alice]( const variant& o ) {
+         return o["id"].as_string() == alice;
+      } ) );
+   }
+
+   // a popped block is followed by a fork record and the block that replaced it
+   const uint32_t fork_block_num = db.head_block_num();
+   db.pop_block();
+   generate_block();
+
+   records = read_delta_stream( dir );
+   {
+      auto fork = std::find_if( records.begin(), records.end(), []( const variant& r ) {
+         return r["type"].as_string() == "fork";
+      } );
+      BOOST_REQUIRE( fork != records.end() && fork + 1 != records.end() );
+      BOOST_CHECK_EQUAL( (*fork)["num"].as_uint64(), fork_block_num - 1 );
+      const variant& replacement = *( fork + 1 );
+      BOOST_CHECK_EQUAL( replacement["type"].as_string(), "block" );
+      BOOST_CHECK_EQUAL( replacement["num"].as_uint64(), fork_block_num );
+      BOOST_CHECK( replacement["id"].as<block_id_type>( 1 ) == db.head_block_id() );
+   }
+
+   // irreversibility is announced as the witnesses confirm blocks
+   generate_blocks( 20 );
+   records = read_delta_stream( dir );
+   const variant& irreversible = last_record_of_type( records, "irreversible" );
+   BOOST_CHECK_EQUAL( irreversible["num"].as_uint64(), db.get_dynamic_global_properties().last_irreversible_block_num );
+
+   // a new file is started once the current one exceeds 1 MiB
+   BOOST_REQUIRE_EQUAL( delta_stream_files( dir ).size(), 1u );
+   for( uint32_t i = 0; i < 5000 && delta_stream_files( dir ).size() < 2; ++i )
+      generate_block();
+   const vector<string> files = delta_stream_files( dir );
+   BOOST_REQUIRE_EQUAL( files.size(), 2u );
+   BOOST_CHECK_GE( boost::filesystem::file_size( files[0] ), 1024u * 1024u );
+   // files start with the records of a block and are named after it
+   const fc::variants second_file = read_records( files[1] );
+   BOOST_REQUIRE( !second_file.empty() );
+   BOOST_CHECK( second_file.front()["type"].as_string() != "irreversible" );
+   auto first_block = std::find_if( second_file.begin(), second_file.end(), []( const variant& r ) {
+      return r["type"].as_string() == "block";
+   } );
+   BOOST_REQUIRE( first_block != second_file.end() );
+   char name[32];
+   std::snprintf( name, sizeof(name), "deltas-%010u.jsonl", uint32_t( (*first_block)["num"].as_uint64() ) );
+   BOOST_CHECK_EQUAL( boost::filesystem::path( files[1] ).filename().generic_string(), name );
+
+   // across files, blocks follow each other except after a fork, and irreversibility only advances
+   records = read_delta_stream( dir );
+   uint32_t next_block_num = 0;
+   uint32_t last_irreversible = 0;
+   for( const variant& record : records )
+   {
+      const string type = record["type"].as_string();
+      const uint32_t num = record["num"].as_uint64();
+      if( type == "block" )
+      {
+         if( next_block_num != 0 )
+            BOOST_CHECK_EQUAL( num, next_block_num );
+         next_block_num = num + 1;
+      }
+      else if( type == "fork" )
+         next_block_num = num + 1;
+      else
+      {
+         BOOST_CHECK_EQUAL( type, "irreversible" );
+         BOOST_CHECK_GT( num, last_irreversible );
+         last_irreversible = num;
+      }
+   }
+   BOOST_CHECK_EQUAL( next_block_num, db.head_block_num() + 1 );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( delta_stream_restart_test )
+{ try {
+   const fc::path dir = data_dir.path() / "delta_stream_restart";
+   boost::program_options::variables_map options;
+   fc::set_option( options, "delta-stream-dir", dir.generic_string() );
+   auto start_plugin = [this,&options]() {
+      auto plugin = std::make_shared<graphene::delta_stream::delta_stream_plugin>( app );
+      plugin->plugin_initialize( options );
+      plugin->plugin_startup();
+      return plugin;
+   };
+
+   const uint32_t first_streamed = db.head_block_num() + 1;
+   auto plugin = start_plugin();
+   generate_blocks( 30 );
+   const uint32_t last_streamed = db.head_block_num();
+   const uint32_t irreversible = db.get_dynamic_global_properties().last_irreversible_block_num;
+   BOOST_REQUIRE_LT( irreversible, last_streamed );
+   plugin->plugin_shutdown();
+   plugin.reset();
+
+   // like database::close(), pop the reversible blocks without telling the plugin
+   while( db.head_block_num() > irreversible )
+      db.pop_block();
+
+   plugin = start_plugin();
+   generate_block();
+   plugin->plugin_shutdown();
+
+   // the stream goes back to where the restarted node continues, and the replacement follows
+   const fc::variants records = read_delta_stream( dir );
+   BOOST_REQUIRE_GE( records.size(), 2u );
+   const variant& fork = records[ records.size() - 2 ];
+   const variant& block = records.back();
+   BOOST_CHECK_EQUAL( fork["type"].as_string(), "fork" );
+   BOOST_CHECK_EQUAL( fork["num"].as_uint64(), irreversible );
+   BOOST_CHECK_EQUAL( block["type"].as_string(), "block" );
+   BOOST_CHECK_EQUAL( block["num"].as_uint64(), irreversible + 1 );
+   BOOST_CHECK( block["id"].as<block_id_type>( 1 ) == db.head_block_id() );
+
+   // each block was written once before the restart, and only the replacement after it
+   const auto blocks = std::count_if( records.begin(), records.end(), []( const variant& r ) {
+      return r["type"].as_string() == "block";
+   } );
+   BOOST_CHECK_EQUAL( blocks, last_streamed - first_streamed + 2 );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_SUITE_END()
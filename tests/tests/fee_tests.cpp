@@ -714,6 +714,56 @@ BOOST_AUTO_TEST_CASE( account_create_fee_scaling )
    BOOST_CHECK_EQUAL(db.get_global_properties().parameters.get_current_fees().get<account_create_operation>().basic_fee, 1u);
 } FC_LOG_AND_RETHROW() }
 
+BOOST_AUTO_TEST_CASE( fee_table_follows_schedule_changes )
+{ try {
+   chain_parameters params;
+   transfer_operation transfer_op;
+   htlc_create_operation htlc_op;
+   htlc_op.claim_period_seconds = 0;
+
+   // missing parameters fall back to the defaults
+   const auto default_transfer_fee = transfer_operation::fee_parameters_type().fee;
+   BOOST_CHECK_EQUAL( params.get_current_fees().calculate_fee( transfer_op ).amount.value, default_transfer_fee );
+   BOOST_CHECK_EQUAL( params.get_current_fees().calculate_fee( htlc_op ).amount.value,
+                      htlc_create_operation::fee_parameters_type().fee );
+
+   // in place changes are picked up
+   transfer_operation::fee_parameters_type transfer_params;
+   transfer_params.fee = 123;
+   params.get_mutable_fees().parameters.insert( transfer_params );
+   BOOST_CHECK_EQUAL( params.get_current_fees().calculate_fee( transfer_op ).amount.value, 123 );
+   params.get_mutable_fees().scale = 2 * GRAPHENE_100_PERCENT;
+   BOOST_CHECK_EQUAL( params.get_current_fees().calculate_fee( transfer_op ).amount.value, 246 );
+
+   // copies calculate the same fees
+   chain_parameters copy = params;
+   BOOST_CHECK_EQUAL( copy.get_current_fees().calculate_fee( transfer_op ).amount.value, 246 );
+   copy.get_mutable_fees().zero_all_fees();
+   BOOST_CHECK_EQUAL( copy.get_current_fees().calculate_fee( transfer_op ).amount.value, 0 );
+   BOOST_CHECK_EQUAL( params.get_current_fees().calculate_fee( transfer_op ).amount.value, 246 );
+
+   // values written through a reference taken before a fee is calculated are picked up
+   fee_schedule schedule;
+   account_create_operation create_op;
+   account_create_operation::fee_parameters_type create_params;
+   create_params.basic_fee = 5;
+   create_params.premium_fee = 5;
+   create_params.price_per_kbyte = 0;
+   schedule.parameters.insert( create_params );
+   auto& stored_create_params = schedule.get<account_create_operation>();
+   BOOST_CHECK_EQUAL( schedule.calculate_fee( create_op ).amount.value, 5 );
+   stored_create_params.basic_fee = 7;
+   stored_create_params.premium_fee = 7;
+   BOOST_CHECK_EQUAL( schedule.calculate_fee( create_op ).amount.value, 7 );
+
+   // so are elements replaced by others of the same count
+   schedule.parameters.erase( schedule.parameters.begin() );
+   schedule.parameters.insert( transfer_params );
+   BOOST_CHECK_EQUAL( schedule.calculate_fee( transfer_op ).amount.value, 123 );
+   BOOST_CHECK_EQUAL( schedule.calculate_fee( create_op ).amount.value,
+                      create_op.calculate_fee( account_create_operation::fee_parameters_type() ).value );
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_CASE( fee_refund_test )
 {
    try
@@ -58,4 +58,158 @@ BOOST_AUTO_TEST_CASE(api_limit_get_grouped_limit_orders) {
     throw;
    }
 }
+
+BOOST_AUTO_TEST_CASE(grouped_limit_orders_book_and_diffs) {
+   try
+   {
+   ACTORS((alice));
+   const asset_object& test = create_user_issued_asset( "TESTUIA" );
+   asset_id_type test_id = test.id;
+   issue_uia( alice, test.amount( 100000 ) );
+   transfer( committee_account, alice_id, asset( 100000 ) );
+   generate_block();
+
+   auto plugin = app.get_plugin<graphene::grouped_orders::grouped_orders_plugin>( "grouped_orders" );
+   BOOST_REQUIRE( plugin );
+   vector<limit_order_group_book_diff> diffs;
+   boost::signals2::scoped_connection connection = plugin->limit_order_groups_changed.connect(
+         [&diffs]( const vector<limit_order_group_book_diff>& d ) { diffs.insert( diffs.end(), d.begin(), d.end() ); } );
+   auto find_diff = [&diffs]( uint16_t group ) {
+      auto itr = std::find_if( diffs.begin(), diffs.end(),
+                               [group]( const limit_order_group_book_diff& d ) { return d.group == group; } );
+      BOOST_REQUIRE( itr != diffs.end() );
+      return *itr;
+   };
+
+   // 1% groups: the first and the third order are grouped, the second is 5% lower
+   create_sell_order( alice_id, asset( 100 ), asset( 100, test_id ) );
+   const limit_order_object* low = create_sell_order( alice_id, asset( 100 ), asset( 105, test_id ) );
+   BOOST_REQUIRE( low );
+   limit_order_id_type low_id = low->id;
+   create_sell_order( alice_id, asset( 1000 ), asset( 1002, test_id ) );
+   generate_block();
+
+   graphene::app::orders_api orders_api(app);
+   std::string core_str = std::string( static_cast<object_id_type>( asset_id_type() ) );
+   std::string test_str = std::string( static_cast<object_id_type>( test_id ) );
+   optional<price> start;
+
+   vector< limit_order_group > orders = orders_api.get_grouped_limit_orders( core_str, test_str, 100, start, 10 );
+   BOOST_REQUIRE_EQUAL( orders.size(), 2u );
+   BOOST_CHECK( orders[0].min_price == price( asset( 1000 ), asset( 1002, test_id ) ) );
+   BOOST_CHECK( orders[0].max_price == price( asset( 100 ), asset( 100, test_id ) ) );
+   BOOST_CHECK_EQUAL( orders[0].total_for_sale.value, 1100 );
+   BOOST_CHECK( orders[1].min_price == price( asset( 100 ), asset( 105, test_id ) ) );
+   BOOST_CHECK_EQUAL( orders[1].total_for_sale.value, 100 );
+
+   BOOST_CHECK_EQUAL( orders_api.get_grouped_limit_orders( core_str, test_str, 10, start, 10 ).size(), 3u );
+   BOOST_CHECK_EQUAL( orders_api.get_grouped_limit_orders( core_str, test_str, 100, start, 1 ).size(), 1u );
+   start = price( asset( 100 ), asset( 104, test_id ) );
+   orders = orders_api.get_grouped_limit_orders( core_str, test_str, 100, start, 10 );
+   BOOST_REQUIRE_EQUAL( orders.size(), 1u );
+   BOOST_CHECK_EQUAL( orders[0].total_for_sale.value, 100 );
+   BOOST_CHECK_EQUAL( orders_api.get_grouped_limit_orders( test_str, core_str, 100, optional<price>(), 10 ).size(),
+                      0u );
+
+   auto diff = find_diff( 100 );
+   BOOST_CHECK( diff.base == asset_id_type() );
+   BOOST_CHECK( diff.quote == test_id );
+   BOOST_REQUIRE_EQUAL( diff.changed.size(), 2u );
+   BOOST_CHECK_EQUAL( diff.changed[0].second.total_for_sale.value, 1100 );
+   BOOST_CHECK_EQUAL( diff.changed[1].second.total_for_sale.value, 100 );
+   BOOST_CHECK_EQUAL( find_diff( 10 ).changed.size(), 3u );
+
+   // removing the only order of a group shows up as a removal
+   diffs.clear();
+   cancel_limit_order( low_id( db ) );
+   generate_block();
+   diff = find_diff( 100 );
+   BOOST_CHECK( diff.changed.empty() );
+   BOOST_REQUIRE_EQUAL( diff.removed.size(), 1u );
+   BOOST_CHECK( diff.removed[0] == price( asset( 100 ), asset( 105, test_id ) ) );
+   BOOST_CHECK_EQUAL( orders_api.get_grouped_limit_orders( core_str, test_str, 100, optional<price>(), 10 ).size(),
+                      1u );
+
+   // nothing changed, nothing is sent
+   diffs.clear();
+   generate_block();
+   BOOST_CHECK( diffs.empty() );
+   }catch (fc::exception &e)
+   {
+    edump((e.to_detail_string()));
+    throw;
+   }
+}
+BOOST_AUTO_TEST_CASE(grouped_limit_orders_subscriptions) {
+   try
+   {
+   ACTORS((alice));
+   const asset_object& test = create_user_issued_asset( "TESTUIA" );
+   asset_id_type test_id = test.id;
+   issue_uia( alice, test.amount( 100000 ) );
+   transfer( committee_account, alice_id, asset( 100000 ) );
+   generate_block();
+
+   // the callbacks hold the API alive, so it has to be owned by a shared_ptr like on a connection
+   auto orders_api = std::make_shared<graphene::app::orders_api>( app );
+   std::string core_str = std::string( static_cast<object_id_type>( asset_id_type() ) );
+   std::string test_str = std::string( static_cast<object_id_type>( test_id ) );
+
+   vector<limit_order_group_book_diff> received;
+   auto callback = [&received]( const variant& v ) {
+      received.push_back( v.as<limit_order_group_book_diff>( GRAPHENE_MAX_NESTED_OBJECTS ) );
+   };
+
+   // the limit is set to 2 for this test
+   GRAPHENE_CHECK_THROW( orders_api->subscribe_to_grouped_limit_orders( callback, core_str, test_str, 5 ),
+                         fc::exception );
+   orders_api->subscribe_to_grouped_limit_orders( callback, core_str, test_str, 10 );
+   orders_api->subscribe_to_grouped_limit_orders( callback, core_str, test_str, 100 );
+   // subscribing again to the same market and group replaces the callback
+   orders_api->subscribe_to_grouped_limit_orders( callback, core_str, test_str, 100 );
+   GRAPHENE_CHECK_THROW( orders_api->subscribe_to_grouped_limit_orders( callback, test_str, core_str, 100 ),
+                         fc::exception );
+
+   create_sell_order( alice_id, asset( 100 ), asset( 100, test_id ) );
+   generate_block();
+   fc::usleep( fc::milliseconds( 100 ) );
+
+   BOOST_REQUIRE_EQUAL( received.size(), 2u );
+   for( const auto& diff : received )
+   {
+      BOOST_CHECK( diff.base == asset_id_type() );
+      BOOST_CHECK( diff.quote == test_id );
+      BOOST_REQUIRE_EQUAL( diff.changed.size(), 1u );
+      BOOST_CHECK_EQUAL( diff.changed[0].second.total_for_sale.value, 100 );
+      BOOST_CHECK( diff.removed.empty() );
+   }
+   BOOST_CHECK( received[0].group != received[1].group );
+
+   // only the remaining subscription is notified, and there is room for another one
+   orders_api->unsubscribe_from_grouped_limit_orders( core_str, test_str, 10 );
+   orders_api->subscribe_to_grouped_limit_orders( callback, test_str, core_str, 100 );
+   received.clear();
+   create_sell_order( alice_id, asset( 100 ), asset( 101, test_id ) );
+   generate_block();
+   fc::usleep( fc::milliseconds( 100 ) );
+
+   BOOST_REQUIRE_EQUAL( received.size(), 1u );
+   BOOST_CHECK_EQUAL( received[0].group, 100u );
+   BOOST_REQUIRE_EQUAL( received[0].changed.size(), 1u );
+   BOOST_CHECK_EQUAL( received[0].changed[0].second.total_for_sale.value, 200 );
+
+   // nothing is sent after unsubscribing from everything
+   orders_api->unsubscribe_from_grouped_limit_orders( core_str, test_str, 100 );
+   orders_api->unsubscribe_from_grouped_limit_orders( test_str, core_str, 100 );
+   received.clear();
+   create_sell_order( alice_id, asset( 100 ), asset( 102, test_id ) );
+   generate_block();
+   fc::usleep( fc::milliseconds( 100 ) );
+   BOOST_CHECK( received.empty() );
+   }catch (fc::exception &e)
+   {
+    edump((e.to_detail_string()));
+    throw;
+   }
+}
 BOOST_AUTO_TEST_SUITE_END()
@@ -28,6 +28,7 @@
 
 #include <graphene/protocol/market.hpp>
 #include <graphene/chain/market_object.hpp>
+#include <graphene/market_history/market_history_plugin.hpp>
 
 #include "../common/database_fixture.hpp"
 
@@ -2459,4 +2460,71 @@ BOOST_AUTO_TEST_CASE(mcfr_rounding_test_after2481)
 
 } FC_LOG_AND_RETHROW() }
 
+/***
+ * Multiple fills of one market in one block should end up in the same bucket,
+ * with the same OHLCV data as if the fills were processed one by one
+ */
+BOOST_AUTO_TEST_CASE(market_history_buckets_with_multiple_fills_in_one_block)
+{ try {
+   using namespace graphene::market_history;
+
+   ACTORS((buyer)(seller));
+
+   const auto& test = create_user_issued_asset("MHTEST");
+   const asset_id_type test_id = test.id;
+   const asset_id_type core_id;
+
+   issue_uia( seller, test.amount(1000) );
+   transfer( committee_account, buyer_id, asset(10000) );
+   generate_block();
+
+   // three maker orders with different prices, filled by one taker order in the same block
+   create_sell_order( seller_id, asset(100, test_id), asset(200) );
+   create_sell_order( seller_id, asset(100, test_id), asset(100) );
+   create_sell_order( seller_id, asset(100, test_id), asset(300) );
+   BOOST_CHECK( !create_sell_order( buyer_id, asset(600), asset(200, test_id) ) );
+   generate_block();
+
+   const auto& by_key_idx = db.get_index_type<bucket_index>().indices().get<by_key>();
+   auto itr = by_key_idx.lower_bound( bucket_key( core_id, test_id, 15, fc::time_point_sec() ) );
+   BOOST_REQUIRE( itr != by_key_idx.end() );
+   BOOST_CHECK( itr->key.base == core_id );
+   BOOST_CHECK( itr->key.quote == test_id );
+   BOOST_CHECK_EQUAL( itr->key.seconds, 15u );
+   BOOST_CHECK_EQUAL( itr->key.open.sec_since_epoch(), db.head_block_time().sec_since_epoch() / 15 * 15 );
+   BOOST_CHECK_EQUAL( itr->open_base.value, 100 );
+   BOOST_CHECK_EQUAL( itr->open_quote.value, 100 );
+   BOOST_CHECK_EQUAL( itr->high_base.value, 300 );
+   BOOST_CHECK_EQUAL( itr->high_quote.value, 100 );
+   BOOST_CHECK_EQUAL( itr->low_base.value, 100 );
+   BOOST_CHECK_EQUAL( itr->low_quote.value, 100 );
+   BOOST_CHECK_EQUAL( itr->close_base.value, 300 );
+   BOOST_CHECK_EQUAL( itr->close_quote.value, 100 );
+   BOOST_CHECK_EQUAL( itr->base_volume.value, 600 );
+   BOOST_CHECK_EQUAL( itr->quote_volume.value, 300 );
+   const object_id_type first_bucket_id = itr->id;
+
+   // another fill in the next block
+   create_sell_order( seller_id, asset(100, test_id), asset(50) );
+   BOOST_CHECK( !create_sell_order( buyer_id, asset(50), asset(100, test_id) ) );
+   generate_block();
+
+   itr = by_key_idx.lower_bound( bucket_key( core_id, test_id, 15, fc::time_point_sec() ) );
+   BOOST_REQUIRE( itr != by_key_idx.end() );
+   BOOST_CHECK( itr->id == first_bucket_id );
+   share_type base_volume = 0;
+   share_type quote_volume = 0;
+   share_type lowest_base = itr->low_base;
+   for( ; itr != by_key_idx.end() && itr->key.base == core_id && itr->key.quote == test_id; ++itr )
+   {
+      base_volume += itr->base_volume;
+      quote_volume += itr->quote_volume;
+      lowest_base = std::min( lowest_base, itr->low_base );
+   }
+   BOOST_CHECK_EQUAL( base_volume.value, 650 );
+   BOOST_CHECK_EQUAL( quote_volume.value, 400 );
+   BOOST_CHECK_EQUAL( lowest_base.value, 50 );
+
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 BitShares Blockchain Foundation, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/metrics/metrics_plugin.hpp>
+
+#include "../common/database_fixture.hpp"
+
+#include <sstream>
+
+using namespace graphene::chain;
+using namespace graphene::chain::test;
+
+namespace {
+
+/// @return the lines of the rendered metrics that start with prefix
+vector<string> metric_lines( const string& metrics, const string& prefix )
+{
+   vector<string> lines;
+   std::istringstream in( metrics );
+   string line;
+   while( std::getline( in, line ) )
+   {
+      if( line.compare( 0, prefix.size(), prefix ) == 0 )
+         lines.push_back( line );
+   }
+   return lines;
+}
+
+/// @return the value of the sample with the given name and labels
+double sample_value( const string& metrics, const string& sample )
+{
+   const vector<string> lines = metric_lines( metrics, sample + ' ' );
+   FC_ASSERT( lines.size() == 1, "Expected one ${s} sample", ("s",sample) );
+   return std::stod( lines.front().substr( sample.size() + 1 ) );
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE( metrics_tests, database_fixture )
+
+BOOST_AUTO_TEST_CASE( metrics_render_test )
+{ try {
+   auto plugin = app.get_plugin<graphene::metrics::metrics_plugin>( "metrics" );
+   BOOST_REQUIRE( plugin );
+
+   ACTOR( alice );
+   generate_blocks( 5 );
+
+   const string metrics = plugin->render_metrics();
+   BOOST_TEST_MESSAGE( metrics );
+
+   BOOST_CHECK_EQUAL( uint64_t( sample_value( metrics, "graphene_head_block_number" ) ), db.head_block_num() );
+   BOOST_CHECK_EQUAL( uint64_t( sample_value( metrics, "graphene_index_objects{space=\"1\",type=\"2\"}" ) ),
+                      db.get_index_type<account_index>().indices().size() );
+
+   // all blocks were applied after startup, each one is observed once, the last one included
+   const auto& counters = db.get_block_processing_counters();
+   BOOST_CHECK_EQUAL( uint64_t( sample_value( metrics, "graphene_blocks_applied_total" ) ), counters.blocks );
+   BOOST_CHECK_EQUAL( uint64_t( sample_value( metrics, "graphene_block_latency_seconds_count" ) ), counters.blocks );
+   BOOST_CHECK( metrics.find( "# TYPE graphene_block_apply_duration_seconds histogram\n" ) != string::npos );
+   BOOST_CHECK_EQUAL( uint64_t( sample_value( metrics, "graphene_block_apply_duration_seconds_count" ) ),
+                      counters.blocks );
+   BOOST_CHECK_EQUAL( uint64_t( sample_value( metrics, "graphene_block_apply_duration_seconds_bucket{le=\"+Inf\"}" ) ),
+                      counters.blocks );
+   BOOST_CHECK_CLOSE( sample_value( metrics, "graphene_block_apply_duration_seconds_sum" ),
+                      double( counters.apply_time ) / 1000000, 0.01 );
+
+   // buckets are cumulative
+   const vector<string> buckets = metric_lines( metrics, "graphene_block_apply_duration_seconds_bucket{" );
+   BOOST_CHECK_EQUAL( buckets.size(), 11u );
+   uint64_t previous = 0;
+   for( const string& bucket : buckets )
+   {
+      const uint64_t value = std::stoull( bucket.substr( bucket.rfind( ' ' ) + 1 ) );
+      BOOST_CHECK_GE( value, previous );
+      previous = value;
+   }
+
+   // nothing is counted twice
+   BOOST_CHECK_EQUAL( uint64_t( sample_value( plugin->render_metrics(), "graphene_block_apply_duration_seconds_count" ) ),
+                      counters.blocks );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_SUITE_END()
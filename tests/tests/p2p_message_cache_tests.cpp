@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 BitShares Blockchain Foundation, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/net/node.hpp>
+#include <graphene/net/peer_connection.hpp>
+// see the note in node.cpp, fee_schedule has to be complete before the net library serializes operations
+#include <graphene/protocol/fee_schedule.hpp>
+
+#include "../../libraries/net/node_impl.hxx"
+
+using namespace graphene::net;
+using graphene::protocol::signed_block;
+
+namespace {
+
+using node_impl_ptr = std::unique_ptr<detail::node_impl, detail::node_impl_deleter>;
+
+/// blocks of different numbers have different timestamps and therefore different IDs
+block_message make_block_message( uint32_t block_num )
+{
+   signed_block block;
+   block.timestamp = fc::time_point_sec( block_num * 3 );
+   return block_message( block );
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( p2p_message_cache_tests )
+
+BOOST_AUTO_TEST_CASE( cached_block_is_shared_between_peers )
+{ try {
+   node_impl_ptr node( new detail::node_impl( "p2p_message_cache_tests" ) );
+
+   const block_message block = make_block_message( 10 );
+   const message_ptr cached = std::make_shared<const message>( block );
+
+   // the send queue of each peer which fetches the block asks the node for it by its block ID
+   message_ptr for_first_peer;
+   message_ptr for_second_peer;
+   node->_thread->async( [&node,&block,&cached,&for_first_peer,&for_second_peer](){
+      node->_message_cache.cache_message( cached, cached->id(), message_propagation_data(), block.block_id );
+      const item_id item( block_message_type, block.block_id );
+      for_first_peer = node->get_message_for_item( item );
+      for_second_peer = node->get_message_for_item( item );
+   }, "cached_block_is_shared_between_peers" ).wait();
+
+   BOOST_CHECK( for_first_peer == cached );
+   BOOST_CHECK( for_second_peer == cached );
+   BOOST_CHECK_EQUAL( for_first_peer.use_count(), 4 );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( message_cache_counters )
+{ try {
+   detail::blockchain_tied_message_cache cache;
+   const block_message block = make_block_message( 10 );
+   const message_ptr cached = std::make_shared<const message>( block );
+   cache.cache_message( cached, cached->id(), message_propagation_data(), block.block_id );
+
+   BOOST_CHECK( cache.get_message( cached->id() ) == cached );
+   BOOST_CHECK( cache.get_message_by_contents_hash( block.block_id ) == cached );
+   BOOST_CHECK_THROW( cache.get_message( block.block_id ), fc::key_not_found_exception );
+   BOOST_CHECK_THROW( cache.get_message_by_contents_hash( make_block_message( 11 ).block_id ),
+                      fc::key_not_found_exception );
+
+   const fc::variant_object info = cache.get_info();
+   BOOST_CHECK_EQUAL( info["messages"].as_uint64(), 1u );
+   BOOST_CHECK_EQUAL( info["size_in_bytes"].as_uint64(), cache.size_in_bytes() );
+   BOOST_CHECK_EQUAL( info["hits"].as_uint64(), 2u );
+   BOOST_CHECK_EQUAL( info["misses"].as_uint64(), 2u );
+   BOOST_CHECK_EQUAL( info["evicted_by_age"].as_uint64(), 0u );
+   BOOST_CHECK_EQUAL( info["evicted_by_size"].as_uint64(), 0u );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( message_cache_eviction )
+{ try {
+   detail::blockchain_tied_message_cache cache;
+   std::vector<message_ptr> messages;
+   for( uint32_t block_num = 1; block_num <= 3; ++block_num )
+   {
+      const block_message block = make_block_message( block_num );
+      messages.push_back( std::make_shared<const message>( block ) );
+      cache.cache_message( messages.back(), messages.back()->id(), message_propagation_data(), block.block_id );
+   }
+   const size_t entry_size = cache.size_in_bytes() / 3;
+   BOOST_REQUIRE_EQUAL( cache.size(), 3u );
+
+   // the oldest entries are evicted first when the budget shrinks
+   cache.set_max_size_in_bytes( 2 * entry_size );
+   BOOST_CHECK_EQUAL( cache.size(), 2u );
+   BOOST_CHECK_EQUAL( cache.size_in_bytes(), 2 * entry_size );
+   BOOST_CHECK_THROW( cache.get_message( messages[0]->id() ), fc::key_not_found_exception );
+   BOOST_CHECK( cache.get_message( messages[1]->id() ) == messages[1] );
+
+   // the newest entry is kept even if it does not fit into the budget alone
+   cache.set_max_size_in_bytes( 1 );
+   BOOST_CHECK_EQUAL( cache.size(), 1u );
+   BOOST_CHECK( cache.get_message( messages[2]->id() ) == messages[2] );
+   BOOST_CHECK_EQUAL( cache.get_info()["evicted_by_size"].as_uint64(), 2u );
+
+   // entries expire after GRAPHENE_NET_MESSAGE_CACHE_DURATION_IN_BLOCKS blocks
+   cache.set_max_size_in_bytes( GRAPHENE_NET_MESSAGE_CACHE_MAX_SIZE_IN_BYTES );
+   for( uint32_t i = 0; i < GRAPHENE_NET_MESSAGE_CACHE_DURATION_IN_BLOCKS; ++i )
+      cache.block_accepted();
+   BOOST_CHECK_EQUAL( cache.size(), 1u );
+   cache.block_accepted();
+   BOOST_CHECK_EQUAL( cache.size(), 0u );
+   BOOST_CHECK_EQUAL( cache.size_in_bytes(), 0u );
+   BOOST_CHECK_EQUAL( cache.get_info()["evicted_by_age"].as_uint64(), 1u );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_SUITE_END()
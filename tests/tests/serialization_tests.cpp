@@ -25,6 +25,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <graphene/chain/database.hpp>
+#include <graphene/net/core_messages.hpp>
 
 
 #include <fc/crypto/digest.hpp>
@@ -55,6 +56,44 @@ BOOST_AUTO_TEST_CASE( serialization_raw_test )
       throw;
    }
 }
+BOOST_AUTO_TEST_CASE( cached_packed_bytes_test )
+{
+   try {
+      ACTOR( alice );
+      transfer_operation op;
+      op.from = account_id_type();
+      op.to = alice_id;
+      op.amount = asset(100);
+      trx.clear();
+      trx.operations.push_back( op );
+      set_expiration( db, trx );
+      sign( trx, init_account_priv_key );
+
+      precomputable_transaction ptrx( trx );
+      BOOST_CHECK( *ptrx.get_packed_signed_transaction() == fc::raw::pack( trx ) );
+      BOOST_CHECK_EQUAL( ptrx.get_packed_size(), fc::raw::pack_size( static_cast<const transaction&>( trx ) ) );
+      BOOST_CHECK( ptrx.id() == trx.id() );
+      BOOST_CHECK( ptrx.get_signature_keys( db.get_chain_id() )
+                   == trx.get_signature_keys( db.get_chain_id() ) );
+      // copies share the packed bytes
+      precomputable_transaction copy( ptrx );
+      BOOST_CHECK( copy.get_packed_signed_transaction() == ptrx.get_packed_signed_transaction() );
+      BOOST_CHECK( graphene::net::trx_message::from_transaction( ptrx ).data
+                   == graphene::net::message( graphene::net::trx_message( trx ) ).data );
+
+      PUSH_TX( db, ptrx, ~0 );
+      const signed_block b = generate_block();
+      BOOST_REQUIRE_EQUAL( b.transactions.size(), 1u );
+      BOOST_CHECK( b.get_packed() == fc::raw::pack( b ) );
+      BOOST_CHECK_EQUAL( b.get_packed_size(), fc::raw::pack_size( b ) );
+      BOOST_CHECK( graphene::net::block_message::from_block( b ).data
+                   == graphene::net::message( graphene::net::block_message( b ) ).data );
+      BOOST_CHECK( *db.fetch_packed_block_by_id( b.id() ) == fc::raw::pack( b ) );
+   } catch (fc::exception& e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
 BOOST_AUTO_TEST_CASE( serialization_json_test )
 {
    try {
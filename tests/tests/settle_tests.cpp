@@ -2124,6 +2124,203 @@ BOOST_AUTO_TEST_CASE( settle_order_cancel_due_to_gs )
    }
 }
 
+/// Tests that the force settlement schedule index tracks the settlement dates of the orders of each asset
+BOOST_AUTO_TEST_CASE( settle_order_schedule_index_test )
+{
+   try {
+
+      set_expiration( db, trx );
+
+      ACTORS((sam)(feeder)(borrower)(seller));
+
+      auto init_amount = 10000000 * GRAPHENE_BLOCKCHAIN_PRECISION;
+      fund( feeder, asset(init_amount) );
+      fund( borrower, asset(init_amount) );
+
+      const auto& mpa = create_bitasset( "SAMMPA", sam_id );
+      asset_id_type mpa_id = mpa.id;
+
+      update_feed_producers( mpa_id, { feeder_id } );
+
+      price_feed f;
+      f.settlement_price = price( asset(100,mpa_id), asset(1) );
+      f.core_exchange_rate = price( asset(100,mpa_id), asset(1) );
+      f.maintenance_collateral_ratio = 1750;
+      f.maximum_short_squeeze_ratio = 1100;
+
+      publish_feed( mpa_id, feeder_id, f );
+
+      borrow( borrower, asset(100000, mpa_id), asset(2000) );
+      transfer( borrower, seller, asset(100000,mpa_id) );
+
+      const auto& dates_by_asset = db.get_index_type< primary_index<force_settlement_index> >()
+                                      .get_secondary_index<force_settlement_schedule_index>()
+                                      .get_dates_by_asset();
+
+      BOOST_CHECK( dates_by_asset.empty() );
+
+      // create two settle orders with different settlement dates
+      force_settle( seller, asset(1000,mpa_id) );
+      generate_block();
+      set_expiration( db, trx );
+      force_settle( seller, asset(1000,mpa_id) );
+
+      const auto& settle_idx = db.get_index_type<force_settlement_index>().indices().get<by_expiration>();
+      BOOST_REQUIRE_EQUAL( settle_idx.size(), 2u );
+      const time_point_sec first_date = settle_idx.begin()->settlement_date;
+      const time_point_sec last_date = settle_idx.rbegin()->settlement_date;
+      BOOST_REQUIRE( first_date < last_date );
+
+      BOOST_REQUIRE_EQUAL( dates_by_asset.size(), 1u );
+      BOOST_CHECK( dates_by_asset.begin()->first == mpa_id );
+      BOOST_REQUIRE_EQUAL( dates_by_asset.begin()->second.size(), 2u );
+      BOOST_CHECK( *dates_by_asset.begin()->second.begin() == first_date );
+      BOOST_CHECK( *dates_by_asset.begin()->second.rbegin() == last_date );
+
+      // the first order is processed at its settlement date, the second one is still scheduled
+      generate_blocks( first_date );
+      BOOST_CHECK_EQUAL( settle_idx.size(), 1u );
+      BOOST_REQUIRE_EQUAL( dates_by_asset.size(), 1u );
+      BOOST_REQUIRE_EQUAL( dates_by_asset.begin()->second.size(), 1u );
+      BOOST_CHECK( *dates_by_asset.begin()->second.begin() == last_date );
+
+      // after the second order is processed, nothing is scheduled
+      generate_blocks( last_date );
+      BOOST_CHECK( settle_idx.empty() );
+      BOOST_CHECK( dates_by_asset.empty() );
+
+   } catch (fc::exception& e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+/// Tests processing settle orders of several assets in one block, where one asset has due settle orders
+/// but hits the volume limit, one has no due settle orders, and one gets globally settled in the same block
+BOOST_AUTO_TEST_CASE( settle_order_multiple_assets_in_one_block )
+{
+   try {
+
+      // Advance to a desired hard fork time
+      // Note: this test doesn't apply after hf2481
+      generate_blocks( HARDFORK_CORE_1780_TIME );
+
+      set_expiration( db, trx );
+
+      ACTORS((sam)(feeder)(borrower)(seller));
+
+      auto init_amount = 10000000 * GRAPHENE_BLOCKCHAIN_PRECISION;
+      fund( sam, asset(init_amount) );
+      fund( feeder, asset(init_amount) );
+      fund( borrower, asset(init_amount) );
+
+      price_feed f;
+      f.maintenance_collateral_ratio = 1850;
+      f.maximum_short_squeeze_ratio = 1250;
+
+      // Create an asset, publish a feed, borrow and give the debt to the seller
+      auto create_mpa = [&]( const string& symbol, uint16_t max_volume ) {
+         asset_create_operation acop;
+         acop.issuer = sam_id;
+         acop.symbol = symbol;
+         acop.precision = 2;
+         acop.common_options.core_exchange_rate = price(asset(1,asset_id_type(1)),asset(1));
+         acop.common_options.max_supply = GRAPHENE_MAX_SHARE_SUPPLY;
+         acop.common_options.issuer_permissions = ASSET_ISSUER_PERMISSION_ENABLE_BITS_MASK;
+         acop.bitasset_opts = bitasset_options();
+         acop.bitasset_opts->minimum_feeds = 1;
+         acop.bitasset_opts->force_settlement_delay_sec = 600;
+         acop.bitasset_opts->maximum_force_settlement_volume = max_volume;
+
+         trx.operations.clear();
+         trx.operations.push_back( acop );
+         processed_transaction ptx = PUSH_TX(db, trx, ~0);
+         asset_id_type mpa_id = db.get<asset_object>(ptx.operation_results[0].get<object_id_type>()).get_id();
+
+         update_feed_producers( mpa_id, { feeder_id } );
+         f.settlement_price = price( asset(100,mpa_id), asset(1) );
+         f.core_exchange_rate = price( asset(100,mpa_id), asset(1) );
+         publish_feed( mpa_id, feeder_id, f );
+
+         BOOST_REQUIRE( borrow( borrower, asset(100000, mpa_id), asset(2000) ) );
+         transfer( borrower, seller, asset(100000,mpa_id) );
+         return mpa_id;
+      };
+
+      // the assets are visited in this order
+      const asset_id_type limited_id = create_mpa( "LIMITEDMPA", 100 ); // 1% of supply per maintenance interval
+      const asset_id_type undue_id = create_mpa( "UNDUEMPA", GRAPHENE_DEFAULT_FORCE_SETTLEMENT_MAX_VOLUME );
+      const asset_id_type gs_id = create_mpa( "GSMPA", GRAPHENE_DEFAULT_FORCE_SETTLEMENT_MAX_VOLUME );
+      BOOST_REQUIRE( limited_id < undue_id && undue_id < gs_id );
+
+      const share_type max_volume = limited_id(db).bitasset_data(db).max_force_settlement_volume(
+                                       limited_id(db).dynamic_data(db).current_supply );
+      BOOST_REQUIRE_EQUAL( max_volume.value, 1000 );
+
+      auto settle = [&]( const asset& amount ) {
+         auto result = force_settle( seller, amount );
+         return force_settlement_id_type( *result.get<extendable_operation_result>().value.new_objects->begin() );
+      };
+      const force_settlement_id_type limited_settle_id = settle( asset(5000, limited_id) );
+      const force_settlement_id_type gs_settle_id = settle( asset(3000, gs_id) );
+      const time_point_sec due_time = limited_settle_id(db).settlement_date;
+
+      generate_block();
+      set_expiration( db, trx );
+
+      // this one is not due when the others are processed
+      generate_blocks( db.head_block_time() + 300 );
+      set_expiration( db, trx );
+      const force_settlement_id_type undue_settle_id = settle( asset(2000, undue_id) );
+      const time_point_sec undue_time = undue_settle_id(db).settlement_date;
+      BOOST_REQUIRE( due_time < undue_time );
+
+      generate_blocks( due_time - GRAPHENE_DEFAULT_BLOCK_INTERVAL );
+      set_expiration( db, trx );
+      BOOST_REQUIRE( db.head_block_time() < due_time );
+      BOOST_CHECK_EQUAL( limited_settle_id(db).balance.amount.value, 5000 );
+      BOOST_CHECK_EQUAL( gs_settle_id(db).balance.amount.value, 3000 );
+
+      // globally settle the last asset in the block in which the settle order of the first asset is due
+      f.settlement_price = price( asset(100,gs_id), asset(10) );
+      f.core_exchange_rate = price( asset(100,gs_id), asset(1) );
+      publish_feed( gs_id, feeder_id, f );
+      BOOST_CHECK( gs_id(db).bitasset_data(db).has_settlement() );
+
+      generate_block();
+      BOOST_REQUIRE( db.head_block_time() >= due_time );
+      BOOST_REQUIRE( db.head_block_time() < undue_time );
+
+      // the first asset is settled up to the volume limit, the order stays
+      BOOST_REQUIRE( db.find( limited_settle_id ) );
+      BOOST_CHECK_EQUAL( limited_settle_id(db).balance.amount.value, 5000 - max_volume.value );
+      BOOST_CHECK_EQUAL( limited_id(db).bitasset_data(db).force_settled_volume.value, max_volume.value );
+
+      // the second asset is untouched
+      BOOST_REQUIRE( db.find( undue_settle_id ) );
+      BOOST_CHECK_EQUAL( undue_settle_id(db).balance.amount.value, 2000 );
+      BOOST_CHECK_EQUAL( undue_id(db).bitasset_data(db).force_settled_volume.value, 0 );
+
+      // the settle order of the globally settled asset is cancelled
+      BOOST_CHECK( !db.find( gs_settle_id ) );
+      BOOST_CHECK_EQUAL( get_balance( seller_id, gs_id ), 100000 );
+
+      // the first asset stays at the volume limit in the following blocks
+      generate_block();
+      BOOST_REQUIRE( db.find( limited_settle_id ) );
+      BOOST_CHECK_EQUAL( limited_settle_id(db).balance.amount.value, 5000 - max_volume.value );
+
+      // the second asset is processed when due
+      generate_blocks( undue_time );
+      BOOST_CHECK( !db.find( undue_settle_id ) );
+      BOOST_CHECK_EQUAL( get_balance( seller_id, undue_id ), 98000 );
+
+   } catch (fc::exception& e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
 /// Tests a scenario that force settlements get cancelled on expiration when there is no sufficient feed
 BOOST_AUTO_TEST_CASE( settle_order_cancel_due_to_no_feed )
 {
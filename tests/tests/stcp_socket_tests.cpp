@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 BitShares Blockchain Foundation, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/net/stcp_socket.hpp>
+#include <graphene/net/config.hpp>
+
+#include <fc/exception/exception.hpp>
+#include <fc/network/tcp_socket.hpp>
+#include <fc/network/ip.hpp>
+#include <fc/thread/thread.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace graphene::net;
+
+namespace {
+
+std::vector<char> make_payload( size_t size, char seed )
+{
+   std::vector<char> payload( size );
+   for( size_t i = 0; i < size; ++i )
+      payload[i] = char( seed + i * 31 );
+   return payload;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( stcp_socket_tests )
+
+/// Small messages are encrypted inline and large ones in the thread pool, the cipher stream must stay in sync
+BOOST_AUTO_TEST_CASE( padded_round_trip )
+{ try {
+   fc::tcp_server server;
+   server.listen( fc::ip::endpoint( fc::ip::address( "127.0.0.1" ), 0 ) );
+
+   stcp_socket receiver;
+   stcp_socket sender;
+   fc::future<void> accepted = fc::async( [&server,&receiver](){
+      server.accept( receiver.get_socket() );
+      receiver.accept();
+   }, "accept" );
+   sender.connect_to( fc::ip::endpoint( fc::ip::address( "127.0.0.1" ), server.get_port() ) );
+   accepted.wait();
+
+   const std::vector<std::vector<char>> payloads {
+      make_payload( 48, 1 ),
+      make_payload( GRAPHENE_NET_PARALLEL_CRYPTO_THRESHOLD, 2 ),
+      make_payload( 32, 3 ),
+      make_payload( MAX_MESSAGE_SIZE, 4 ),
+      make_payload( GRAPHENE_NET_PARALLEL_CRYPTO_THRESHOLD - 16, 5 )
+   };
+
+   // the large messages do not fit into the socket buffers, so they are sent while they are received
+   fc::future<void> sent = fc::async( [&sender,&payloads](){
+      for( const auto& payload : payloads )
+      {
+         std::vector<char> data( payload );
+         sender.write_padded( std::move(data) );
+         sender.flush();
+      }
+   }, "send" );
+
+   for( const auto& payload : payloads )
+   {
+      // the first bytes are kept as they are, like the part of the header read before the body
+      std::vector<char> received( payload.size() + 16, 'x' );
+      receiver.read_padded( received, 16 );
+      BOOST_REQUIRE_EQUAL( received.size(), payload.size() + 16 );
+      BOOST_CHECK( std::all_of( received.begin(), received.begin() + 16, []( char c ){ return c == 'x'; } ) );
+      BOOST_CHECK( std::equal( payload.begin(), payload.end(), received.begin() + 16 ) );
+   }
+   sent.wait();
+
+   sender.close();
+   receiver.close();
+   server.close();
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_SUITE_END()